@@ -0,0 +1,103 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/cfg_cache.hpp>
+#include <fixpoint/changed_lines.hpp>
+
+namespace ia::fixpoint
+{
+  class ControlFlowVisitor;
+
+  // ControlFlowVisitor matches of the current function, walked together once the matchers move on to another
+  // function (or the translation unit ends): every CFG is traversed once and each event fans out to all of them.
+  class ControlFlowBatch
+  {
+public:
+    explicit ControlFlowBatch(MutRef<CFGCache> cfg_cache) : m_cfg_cache(cfg_cache)
+    {
+    }
+
+    // Queues `visitor` for `func`, first flushing the visitors queued for a different function.
+    auto add(ControlFlowVisitor *visitor, const FunctionDecl *func, Ref<MatchResult> result) -> void;
+
+    auto flush() -> void;
+
+private:
+    struct PendingVisit
+    {
+      ControlFlowVisitor *visitor;
+
+      // A copy, as the finder's MatchResult only lives during the callback.
+      MatchResult result;
+    };
+
+    CFGCache &m_cfg_cache;
+    const FunctionDecl *m_func{};
+    Vec<PendingVisit> m_pending;
+  };
+
+  // State shared by all tasks of a workload while they analyze one translation unit. It is created before the
+  // matchers run and destroyed at the end of the translation unit.
+  class AnalysisContext
+  {
+public:
+    [[nodiscard]] auto get_cfg_cache() -> MutRef<CFGCache>
+    {
+      return m_cfg_cache;
+    }
+
+    [[nodiscard]] auto get_cfg_cache() const -> Ref<CFGCache>
+    {
+      return m_cfg_cache;
+    }
+
+    auto set_fuse_control_flow_visitors(bool enabled) -> void
+    {
+      m_fuse_control_flow_visitors = enabled;
+    }
+
+    // The batch ControlFlowVisitor tasks queue their matches in, or nullptr if they walk their CFGs on their own.
+    [[nodiscard]] auto get_control_flow_batch() -> ControlFlowBatch *
+    {
+      return m_fuse_control_flow_visitors ? &m_control_flow_batch : nullptr;
+    }
+
+    // Restricts the analysis to the declarations overlapping these lines; nullptr analyzes everything.
+    auto set_changed_lines(const ChangedLines *changed_lines) -> void
+    {
+      m_changed_lines = changed_lines;
+    }
+
+    // Whether `decl` is in scope: true unless a diff limits the analysis and `decl` doesn't overlap its changes.
+    [[nodiscard]] auto is_changed(const Decl *decl) const -> bool
+    {
+      return !m_changed_lines || m_changed_lines->overlaps(decl);
+    }
+
+    // Runs whatever work the tasks left pending; called once the matchers are done with the translation unit.
+    auto finish() -> void
+    {
+      m_control_flow_batch.flush();
+    }
+
+private:
+    CFGCache m_cfg_cache;
+    ControlFlowBatch m_control_flow_batch{m_cfg_cache};
+    bool m_fuse_control_flow_visitors{false};
+    const ChangedLines *m_changed_lines{};
+  };
+} // namespace ia::fixpoint
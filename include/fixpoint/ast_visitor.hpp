@@ -19,6 +19,8 @@
 
 namespace ia::fixpoint
 {
+  template<typename... Visitors> class FusedASTVisitor;
+
   template<typename Derived> class ASTVisitor : public IWorkloadTask, public clang::RecursiveASTVisitor<Derived>
   {
 public:
@@ -50,6 +52,8 @@ protected:
     }
 
 private:
+    template<typename... Visitors> friend class FusedASTVisitor;
+
     const MatchResult *m_last_match_result{};
   };
 } // namespace ia::fixpoint
\ No newline at end of file
@@ -0,0 +1,87 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/pch.hpp>
+
+#include <clang/Analysis/CFG.h>
+#include <llvm/ADT/DenseMap.h>
+
+#include <bitset>
+
+namespace ia::fixpoint
+{
+  enum class CFGGranularity
+  {
+    // Every subexpression is an element of its own (clang::CFG::BuildOptions::setAllAlwaysAdd()).
+    AllExpressions,
+
+    // Only full statements (and the expressions control flow splits up) are elements, plus subexpressions of the
+    // classes in CFGOptions::stmt_classes.
+    Statements,
+  };
+
+  // The subset of clang::CFG::BuildOptions that tasks choose from. Tasks asking for equal options share one CFG.
+  struct CFGOptions
+  {
+    bool prune_trivially_false_edges{true};
+    bool add_implicit_dtors{true};
+    bool add_initializers{true};
+
+    CFGGranularity granularity{CFGGranularity::AllExpressions};
+    std::bitset<clang::Stmt::lastStmtConstant + 1> stmt_classes;
+
+    auto operator==(const CFGOptions &) const -> bool = default;
+
+    [[nodiscard]] auto to_build_options() const -> clang::CFG::BuildOptions;
+  };
+
+  struct CFGCacheStats
+  {
+    u64 builds{0};
+    u64 hits{0};
+
+    auto operator+=(const CFGCacheStats &other) -> CFGCacheStats &
+    {
+      builds += other.builds;
+      hits += other.hits;
+      return *this;
+    }
+  };
+
+  // Owns the CFGs built for one translation unit, so every task analyzing a function reuses the same graph.
+  class CFGCache
+  {
+public:
+    // Returns nullptr if Clang can't build a CFG for the function (failures are cached as well).
+    auto get(const FunctionDecl *func, clang::ASTContext *ctx, Ref<CFGOptions> options) -> const clang::CFG *;
+
+    [[nodiscard]] auto get_stats() const -> Ref<CFGCacheStats>
+    {
+      return m_stats;
+    }
+
+private:
+    // CFGs are keyed on the index of their options in m_options; a TU sees only a handful of distinct options.
+    Vec<CFGOptions> m_options;
+    llvm::DenseMap<std::pair<const FunctionDecl *, u32>, std::unique_ptr<clang::CFG>> m_cfgs;
+    CFGCacheStats m_stats;
+  };
+
+  // Looks the CFG up in `cache` if there is one, and otherwise builds it into `storage`.
+  auto get_cfg(CFGCache *cache, const FunctionDecl *func, clang::ASTContext *ctx, Ref<CFGOptions> options,
+               MutRef<std::unique_ptr<clang::CFG>> storage) -> const clang::CFG *;
+} // namespace ia::fixpoint
@@ -0,0 +1,81 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/pch.hpp>
+
+#include <clang/Analysis/CFG.h>
+
+#include <queue>
+
+namespace ia::fixpoint
+{
+  enum class DataFlowDirection
+  {
+    // States flow from the entry block along successor edges, through the elements of each block front to back.
+    Forward,
+
+    // States flow from the exit block along predecessor edges, through the elements of each block back to front.
+    Backward,
+  };
+
+  // The order a solve in `direction` should hand out blocks in: reverse post-order of a CFG (from the entry block)
+  // for forward problems, post-order for backward ones, so that in both cases a block comes after the blocks
+  // flowing into it unless a back edge is involved. Blocks that are unreachable from the entry come last, in
+  // storage order, so every block of the CFG has an index.
+  class CFGOrder
+  {
+public:
+    explicit CFGOrder(Ref<clang::CFG> cfg, DataFlowDirection direction = DataFlowDirection::Forward);
+
+    [[nodiscard]] auto get_blocks() const -> Ref<Vec<const CFGBlock *>>
+    {
+      return m_blocks;
+    }
+
+    [[nodiscard]] auto get_index(const CFGBlock *block) const -> u32
+    {
+      return m_indices[block->getBlockID()];
+    }
+
+private:
+    Vec<const CFGBlock *> m_blocks;
+    Vec<u32> m_indices;
+  };
+
+  // Hands out the queued block that comes first in the given order, so a block is (in the absence of back edges)
+  // only processed once all its predecessors are. Blocks that are already queued aren't queued twice.
+  class CFGWorklist
+  {
+public:
+    explicit CFGWorklist(Ref<CFGOrder> order);
+
+    auto push(const CFGBlock *block) -> void;
+
+    // Returns nullptr once the worklist is empty.
+    auto pop() -> const CFGBlock *;
+
+    [[nodiscard]] auto empty() const -> bool
+    {
+      return m_queue.empty();
+    }
+
+private:
+    const CFGOrder &m_order;
+    std::priority_queue<u32, Vec<u32>, std::greater<u32>> m_queue;
+    Vec<bool> m_queued;
+  };
+} // namespace ia::fixpoint
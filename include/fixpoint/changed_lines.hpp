@@ -0,0 +1,59 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/pch.hpp>
+
+namespace ia::fixpoint
+{
+  // The lines a unified diff (`git diff`, `diff -u`) adds or modifies, per file of the new side. A pure deletion
+  // marks the lines around it, so a function that only lost statements still counts as changed.
+  class ChangedLines
+  {
+public:
+    static auto parse(LLVM_StringRef diff) -> Result<ChangedLines>;
+
+    static auto load(Ref<String> path) -> Result<ChangedLines>;
+
+public:
+    [[nodiscard]] auto empty() const -> bool
+    {
+      return m_files.empty();
+    }
+
+    // Whether the diff touches `path`. The diff's paths are relative, so they match any path ending in them.
+    [[nodiscard]] auto contains_file(LLVM_StringRef path) const -> bool;
+
+    // Whether any of the lines [first_line, last_line] of `path` changed.
+    [[nodiscard]] auto overlaps(LLVM_StringRef path, u32 first_line, u32 last_line) const -> bool;
+
+    // Whether the source range of `decl` (macro expansions included) overlaps a changed line.
+    [[nodiscard]] auto overlaps(const Decl *decl) const -> bool;
+
+private:
+    struct ChangedFile
+    {
+      String path;
+
+      // Sorted, disjoint and non-adjacent [first, last] line ranges.
+      Vec<std::pair<u32, u32>> ranges;
+    };
+
+    [[nodiscard]] auto find_file(LLVM_StringRef path) const -> const ChangedFile *;
+
+    Vec<ChangedFile> m_files;
+  };
+} // namespace ia::fixpoint
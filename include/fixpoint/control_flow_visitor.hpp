@@ -15,7 +15,7 @@
 
 #pragma once
 
-#include <fixpoint/pch.hpp>
+#include <fixpoint/analysis_context.hpp>
 
 namespace ia::fixpoint
 {
@@ -51,6 +51,11 @@ public:
       AU_UNUSED(stmt);
     }
 
+    [[nodiscard]] virtual auto get_cfg_options() const -> CFGOptions
+    {
+      return {};
+    }
+
 public:
     auto run(Ref<MatchResult> result) -> void override;
 
@@ -61,6 +66,11 @@ protected:
     }
 
 private:
+    friend class ControlFlowBatch;
+
+    // Walks `cfg` once, handing every block, element and terminator event to each of `visitors` in turn.
+    static auto walk(Ref<clang::CFG> cfg, Ref<Vec<ControlFlowVisitor *>> visitors) -> void;
+
     const MatchResult *m_last_match_result{};
   };
 } // namespace ia::fixpoint
\ No newline at end of file
@@ -0,0 +1,385 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/analysis_context.hpp>
+#include <fixpoint/cfg_order.hpp>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/STLExtras.h>
+
+#include <limits>
+#include <optional>
+
+namespace ia::fixpoint
+{
+  template<typename T>
+  concept DataFlowState = std::default_initializable<T> && std::copy_constructible<T> && std::equality_comparable<T>;
+
+  struct DataFlowStats
+  {
+    u64 functions{0};
+
+    // CFG blocks of the analyzed functions, and how often the solver ran a block's transfer functions. The
+    // closer the two are, the fewer times blocks were revisited before reaching the fixpoint.
+    u64 blocks{0};
+    u64 block_visits{0};
+
+    // Block in-states kept alive during the solves (one per block unless StateStorage::JoinPoints is used).
+    u64 stored_states{0};
+
+    // Functions whose solve ran out of DataFlowLimits::iteration_budget and fell back to the fallback state.
+    u64 budget_exhausted{0};
+
+    auto operator+=(const DataFlowStats &other) -> DataFlowStats &
+    {
+      functions += other.functions;
+      blocks += other.blocks;
+      block_visits += other.block_visits;
+      stored_states += other.stored_states;
+      budget_exhausted += other.budget_exhausted;
+      return *this;
+    }
+  };
+
+  struct DataFlowLimits
+  {
+    // Block visits per function after which the solve is abandoned and every block's in-state (but the entry's) is
+    // set to the fallback state, which must be a safe over-approximation. 0 means no budget.
+    u64 iteration_budget{0};
+
+    // Descending passes run after the (widened) fixpoint: every block's in-state is recomputed from its
+    // predecessors and loop heads go through narrow_into(), recovering precision lost to widening.
+    u32 narrowing_passes{0};
+  };
+
+  enum class StateStorage
+  {
+    // Keep the in-state of every CFG block.
+    AllBlocks,
+
+    // Keep in-states only for the start block, blocks with several predecessors and loop heads. Saves most of the
+    // memory of large functions, at the cost of re-running the transfer functions of single-predecessor blocks
+    // whenever their predecessor is revisited.
+    JoinPoints,
+  };
+
+  // The fixpoint iteration over one function's CFG, shared by the data flow solvers. `HooksT` provides
+  //   join_into(MutRef<StateT> target, Ref<StateT> incoming) -> bool
+  //   widen_into(MutRef<StateT> target, Ref<StateT> incoming) -> bool     (joins at loop heads)
+  //   narrow_into(MutRef<StateT> target, Ref<StateT> recomputed) -> bool (loop heads in narrowing passes)
+  //   transfer_element(Ref<clang::CFGElement> element, MutRef<StateT> state) -> void
+  //   get_fallback_state() -> StateT
+  // and is a template parameter so statically dispatched solvers get those calls inlined.
+  //
+  // "In-state", "before" and "predecessor" are meant in the direction of the flow: a backward solve starts from
+  // the exit block, and the in-state of a block is the state at its end. `order` has to be a CFGOrder built for
+  // the same direction.
+  template<DataFlowState StateT, typename HooksT, DataFlowDirection Direction = DataFlowDirection::Forward>
+  class DataFlowEngine
+  {
+public:
+    DataFlowEngine(MutRef<HooksT> hooks, Ref<clang::CFG> cfg, Ref<CFGOrder> order, StateStorage storage);
+
+    auto solve(ForwardRef<StateT> initial_state, Ref<DataFlowLimits> limits, MutRef<DataFlowStats> stats) -> void;
+
+    // The converged in-state of `block`.
+    auto get_block_in_state(const CFGBlock *block) -> StateT;
+
+    // The converged state right before `stmt` is transferred, or std::nullopt if `stmt` isn't an element of the
+    // CFG. For backward solves that is the state right after `stmt` in program order.
+    auto get_state_before(const Stmt *stmt) -> std::optional<StateT>;
+
+private:
+    static constexpr bool IS_FORWARD = Direction == DataFlowDirection::Forward;
+
+    static auto get_start_block(Ref<clang::CFG> cfg) -> const CFGBlock *
+    {
+      return IS_FORWARD ? &cfg.getEntry() : &cfg.getExit();
+    }
+
+    // The blocks whose out-states flow into `block`, and the ones `block`'s out-state flows into.
+    static auto flow_preds(const CFGBlock *block)
+    {
+      return IS_FORWARD ? block->preds() : block->succs();
+    }
+
+    static auto flow_succs(const CFGBlock *block)
+    {
+      return IS_FORWARD ? block->succs() : block->preds();
+    }
+
+    // The element at `index` in transfer order.
+    static auto get_element(const CFGBlock *block, u32 index) -> clang::CFGElement
+    {
+      return (*block)[IS_FORWARD ? index : block->size() - 1 - index];
+    }
+
+    auto transfer_block(const CFGBlock *block, MutRef<StateT> state) -> void
+    {
+      if constexpr (IS_FORWARD)
+      {
+        for (const auto &element : *block)
+          m_hooks.transfer_element(element, state);
+      }
+      else
+      {
+        for (const auto &element : llvm::reverse(*block))
+          m_hooks.transfer_element(element, state);
+      }
+    }
+
+    auto narrow(MutRef<DataFlowStats> stats) -> bool;
+
+    static constexpr u32 NO_SLOT = std::numeric_limits<u32>::max();
+
+    HooksT &m_hooks;
+    const clang::CFG &m_cfg;
+    const CFGOrder &m_order;
+
+    // Blocks with a stored in-state get a slot. With StateStorage::JoinPoints that is only the start block, join
+    // points and loop heads; every other block has exactly one predecessor and is transferred right after it.
+    std::vector<u32> m_slot_of;
+    std::vector<const CFGBlock *> m_stored_blocks;
+    std::vector<StateT> m_block_in_states;
+
+    // Per slot: the block is the target of a back edge (in reverse post-order), where widening applies.
+    std::vector<bool> m_is_loop_head;
+
+    // Statement -> block and element index (in transfer order), built on the first query.
+    llvm::DenseMap<const Stmt *, std::pair<const CFGBlock *, u32>> m_locations;
+
+    // The state before element `m_cursor_index` of `m_cursor_block`, so queries moving along a block in transfer
+    // order only replay the elements in between.
+    const CFGBlock *m_cursor_block{};
+    u32 m_cursor_index{0};
+    StateT m_cursor_state;
+  };
+
+  template<DataFlowState StateT, typename HooksT, DataFlowDirection Direction>
+  DataFlowEngine<StateT, HooksT, Direction>::DataFlowEngine(MutRef<HooksT> hooks, Ref<clang::CFG> cfg,
+                                                            Ref<CFGOrder> order, StateStorage storage)
+      : m_hooks(hooks), m_cfg(cfg), m_order(order), m_slot_of(cfg.getNumBlockIDs(), NO_SLOT)
+  {
+    const bool lean = storage == StateStorage::JoinPoints;
+    const CFGBlock *start_block = get_start_block(cfg);
+
+    for (const auto *block : order.get_blocks())
+    {
+      u32 pred_count = 0;
+      bool is_loop_head = false;
+      for (const CFGBlock *pred : flow_preds(block))
+      {
+        if (!pred)
+          continue;
+
+        pred_count++;
+        is_loop_head |= order.get_index(pred) >= order.get_index(block);
+      }
+
+      if (!lean || block == start_block || pred_count != 1 || is_loop_head)
+      {
+        m_slot_of[block->getBlockID()] = static_cast<u32>(m_stored_blocks.size());
+        m_stored_blocks.push_back(block);
+        m_is_loop_head.push_back(is_loop_head);
+      }
+    }
+
+    m_block_in_states.resize(m_stored_blocks.size());
+  }
+
+  template<DataFlowState StateT, typename HooksT, DataFlowDirection Direction>
+  auto DataFlowEngine<StateT, HooksT, Direction>::solve(ForwardRef<StateT> initial_state, Ref<DataFlowLimits> limits,
+                                                        MutRef<DataFlowStats> stats) -> void
+  {
+    const auto start_slot = m_slot_of[get_start_block(m_cfg)->getBlockID()];
+    m_block_in_states[start_slot] = std::move(initial_state);
+
+    // Every block is seeded (so each one is transferred at least once) and then handed out in the order of
+    // `m_order`, which processes a block after its predecessors (in the direction of the flow) and keeps the
+    // revisits down to the loops.
+    CFGWorklist worklist(m_order);
+
+    for (const auto *block : m_stored_blocks)
+      worklist.push(block);
+
+    stats.functions++;
+    stats.blocks += m_order.get_blocks().size();
+    stats.stored_states += m_stored_blocks.size();
+
+    std::vector<std::pair<const CFGBlock *, StateT>> pending;
+    u64 visits = 0;
+
+    while (const CFGBlock *stored_block = worklist.pop())
+    {
+      pending.emplace_back(stored_block, m_block_in_states[m_slot_of[stored_block->getBlockID()]]);
+
+      while (!pending.empty())
+      {
+        if (limits.iteration_budget && visits >= limits.iteration_budget)
+        {
+          for (u32 slot = 0; slot < m_block_in_states.size(); ++slot)
+          {
+            if (slot != start_slot)
+              m_block_in_states[slot] = m_hooks.get_fallback_state();
+          }
+
+          stats.budget_exhausted++;
+          return;
+        }
+
+        auto [block, current_state] = std::move(pending.back());
+        pending.pop_back();
+
+        visits++;
+        stats.block_visits++;
+        transfer_block(block, current_state);
+
+        for (const CFGBlock *succ : flow_succs(block))
+        {
+          if (!succ)
+            continue;
+
+          const auto slot = m_slot_of[succ->getBlockID()];
+          if (slot == NO_SLOT)
+            pending.emplace_back(succ, current_state);
+          else if (m_is_loop_head[slot] ? m_hooks.widen_into(m_block_in_states[slot], current_state)
+                                        : m_hooks.join_into(m_block_in_states[slot], current_state))
+            worklist.push(succ);
+        }
+      }
+    }
+
+    for (u32 pass = 0; pass < limits.narrowing_passes; ++pass)
+    {
+      if (!narrow(stats))
+        break;
+    }
+  }
+
+  template<DataFlowState StateT, typename HooksT, DataFlowDirection Direction>
+  auto DataFlowEngine<StateT, HooksT, Direction>::narrow(MutRef<DataFlowStats> stats) -> bool
+  {
+    // Recompute every stored in-state from the out-states of its predecessors, in the solve order. Starting from a
+    // post-fixpoint, each recomputed state is still a sound over-approximation.
+    bool changed = false;
+    const CFGBlock *start_block = get_start_block(m_cfg);
+
+    for (u32 slot = 0; slot < m_stored_blocks.size(); ++slot)
+    {
+      const CFGBlock *block = m_stored_blocks[slot];
+      if (block == start_block)
+        continue;
+
+      std::optional<StateT> joined;
+      for (const CFGBlock *pred : flow_preds(block))
+      {
+        if (!pred)
+          continue;
+
+        StateT out_state = get_block_in_state(pred);
+        stats.block_visits++;
+        transfer_block(pred, out_state);
+
+        if (!joined)
+          joined = std::move(out_state);
+        else
+          m_hooks.join_into(*joined, out_state);
+      }
+
+      if (!joined)
+        continue;
+
+      auto &state = m_block_in_states[slot];
+      if (m_is_loop_head[slot])
+        changed |= m_hooks.narrow_into(state, *joined);
+      else if (!(state == *joined))
+      {
+        state = std::move(*joined);
+        changed = true;
+      }
+    }
+
+    return changed;
+  }
+
+  template<DataFlowState StateT, typename HooksT, DataFlowDirection Direction>
+  auto DataFlowEngine<StateT, HooksT, Direction>::get_block_in_state(const CFGBlock *block) -> StateT
+  {
+    // Blocks without a slot have a single predecessor: walk back to the closest stored block, then replay forward.
+    std::vector<const CFGBlock *> chain;
+    const CFGBlock *stored = block;
+
+    while (m_slot_of[stored->getBlockID()] == NO_SLOT)
+    {
+      chain.push_back(stored);
+
+      for (const CFGBlock *pred : flow_preds(stored))
+      {
+        if (pred)
+        {
+          stored = pred;
+          break;
+        }
+      }
+    }
+
+    StateT state = m_block_in_states[m_slot_of[stored->getBlockID()]];
+    if (chain.empty())
+      return state;
+
+    transfer_block(stored, state);
+    for (size_t i = chain.size() - 1; i > 0; --i)
+      transfer_block(chain[i], state);
+
+    return state;
+  }
+
+  template<DataFlowState StateT, typename HooksT, DataFlowDirection Direction>
+  auto DataFlowEngine<StateT, HooksT, Direction>::get_state_before(const Stmt *stmt) -> std::optional<StateT>
+  {
+    if (m_locations.empty())
+    {
+      for (const auto *block : m_order.get_blocks())
+      {
+        for (u32 index = 0; index < block->size(); ++index)
+        {
+          if (auto cfg_stmt = get_element(block, index).getAs<clang::CFGStmt>())
+            m_locations.try_emplace(cfg_stmt->getStmt(), block, index);
+        }
+      }
+    }
+
+    const auto it = m_locations.find(stmt);
+    if (it == m_locations.end())
+      return std::nullopt;
+
+    const auto [block, index] = it->second;
+
+    if (m_cursor_block != block || m_cursor_index > index)
+    {
+      m_cursor_state = get_block_in_state(block);
+      m_cursor_block = block;
+      m_cursor_index = 0;
+    }
+
+    for (u32 position = m_cursor_index; position < index; ++position)
+      m_hooks.transfer_element(get_element(block, position), m_cursor_state);
+
+    m_cursor_index = index;
+    return m_cursor_state;
+  }
+} // namespace ia::fixpoint
@@ -15,18 +15,49 @@
 
 #pragma once
 
-#include <fixpoint/pch.hpp>
+#include <fixpoint/data_flow_engine.hpp>
+#include <fixpoint/utils.hpp>
 
 namespace ia::fixpoint
 {
-  template<typename T>
-  concept DataFlowState = std::default_initializable<T> && std::copy_constructible<T> && std::equality_comparable<T>;
-
-  template<DataFlowState StateT> class DataFlowSolver : public IWorkloadTask
+  // With DataFlowDirection::Backward, states flow from the exit block against the control flow (see
+  // BackwardDataFlowSolver); get_initial_state() is then the state at the exit of the function.
+  template<DataFlowState StateT, DataFlowDirection Direction = DataFlowDirection::Forward>
+  class DataFlowSolver : public IWorkloadTask
   {
 public:
     [[nodiscard]] virtual auto merge(Ref<StateT> current_state, Ref<StateT> incoming_state) -> StateT = 0;
 
+    // Joins `incoming_state` into `target` in place and returns whether `target` changed. The solver always goes
+    // through this hook; override it for large states to skip the temporary from merge() and the full comparison.
+    virtual auto join_into(MutRef<StateT> target, Ref<StateT> incoming_state) -> bool
+    {
+      StateT merged = merge(target, incoming_state);
+      if (merged == target)
+        return false;
+
+      target = std::move(merged);
+      return true;
+    }
+
+    // Used instead of join_into() for the edges into loop heads. Lattices of infinite height override it to
+    // extrapolate (e.g. push a growing bound to infinity) so loops converge in a few passes.
+    virtual auto widen_into(MutRef<StateT> target, Ref<StateT> incoming_state) -> bool
+    {
+      return join_into(target, incoming_state);
+    }
+
+    // Refines a loop head's widened `target` with the state recomputed from its predecessors during the narrowing
+    // passes (see DataFlowLimits). Returns whether `target` changed.
+    virtual auto narrow_into(MutRef<StateT> target, Ref<StateT> recomputed_state) -> bool
+    {
+      if (target == recomputed_state)
+        return false;
+
+      target = recomputed_state;
+      return true;
+    }
+
     virtual auto transfer(const Stmt *s, MutRef<StateT> state) -> void = 0;
 
     virtual auto transfer_initializer(const CXXCtorInitializer *init, MutRef<StateT> state) -> void
@@ -43,22 +74,91 @@ public:
 
     [[nodiscard]] virtual auto get_initial_state() -> StateT = 0;
 
+    // The state every block gets when a solve exceeds DataFlowLimits::iteration_budget. Override it together with
+    // get_limits(); it has to hold on any path (usually the top of the lattice).
+    [[nodiscard]] virtual auto get_fallback_state() -> StateT
+    {
+      return get_initial_state();
+    }
+
+    [[nodiscard]] virtual auto get_limits() const -> DataFlowLimits
+    {
+      return {};
+    }
+
+    [[nodiscard]] virtual auto get_cfg_options() const -> CFGOptions
+    {
+      return {};
+    }
+
+    [[nodiscard]] virtual auto get_state_storage() const -> StateStorage
+    {
+      return StateStorage::AllBlocks;
+    }
+
+    // Threads solving the functions of one match (a record's methods or a translation unit's functions) at the
+    // same time, 0 meaning one per hardware thread. The CFGs are still built on the matching thread and
+    // on_function_solved() is still called there, in source order, but merge(), join_into(), the transfer
+    // functions and the other lattice hooks run concurrently and must not touch shared task state. The AST isn't
+    // read-only either: they must not make memoizing ASTContext queries (getTypeSize(), getTypeInfo(), record
+    // layouts, ... and so utils::fits_in_register() or utils::is_cheap_to_copy()); compute those while building
+    // the initial state or in on_function_solved() instead. ASTs backed by an external source (e.g. loaded from
+    // ToolSettings::ast_cache_dir) deserialize whatever gets touched, so they are always solved on one thread.
+    [[nodiscard]] virtual auto get_solve_jobs() const -> u32
+    {
+      return 1;
+    }
+
+    // Called once the states of `func` converged. This is the place to query get_state_before() instead of
+    // recording states from transfer(), which also runs on every non-final iteration.
+    virtual auto on_function_solved(const FunctionDecl *func) -> void
+    {
+      AU_UNUSED(func);
+    }
+
 public:
     auto run(Ref<MatchResult> result) -> void override;
 
+    [[nodiscard]] auto get_stats() const -> Ref<DataFlowStats>
+    {
+      return m_stats;
+    }
+
 protected:
     auto get_match_result() -> const MatchResult *
     {
       return m_last_match_result;
     }
 
+    // The converged state right before `stmt`, recomputed by replaying the transfer functions of its block (and,
+    // with StateStorage::JoinPoints, of the blocks since the last stored state). Only available from
+    // on_function_solved(); returns std::nullopt otherwise or if `stmt` isn't an element of the CFG. For backward
+    // solvers this is the state before `stmt` is transferred, i.e. right after it in program order.
+    auto get_state_before(const Stmt *stmt) -> std::optional<StateT>;
+
+    // True while get_state_before() replays transfer functions, so tasks can skip their side effects.
+    [[nodiscard]] auto is_replaying() const -> bool
+    {
+      return m_replaying;
+    }
+
 private:
+    using Engine = DataFlowEngine<StateT, DataFlowSolver, Direction>;
+    friend Engine;
+
     auto analyze_function(const FunctionDecl *func, clang::ASTContext *ctx) -> void;
+    auto analyze_functions(Ref<Vec<const FunctionDecl *>> funcs, clang::ASTContext *ctx) -> void;
+    auto should_analyze(const FunctionDecl *func, clang::ASTContext *ctx) const -> bool;
+    auto transfer_element(Ref<clang::CFGElement> element, MutRef<StateT> state) -> void;
 
     const MatchResult *m_last_match_result{};
+    DataFlowStats m_stats;
+    Engine *m_engine{};
+    bool m_replaying{false};
   };
 
-  template<DataFlowState StateT> auto DataFlowSolver<StateT>::run(Ref<MatchResult> result) -> void
+  template<DataFlowState StateT, DataFlowDirection Direction>
+  auto DataFlowSolver<StateT, Direction>::run(Ref<MatchResult> result) -> void
   {
     const auto *decl = result.Nodes.getNodeAs<Decl>("decl");
     if (!decl)
@@ -68,111 +168,175 @@ private:
 
     auto *ctx = result.Context;
 
+    Vec<const FunctionDecl *> funcs;
+
     if (const auto func = llvm_cast<const FunctionDecl>(decl))
-      analyze_function(func, ctx);
+      funcs.push_back(func);
     else if (const auto record = llvm_cast<const CXXRecordDecl>(decl))
     {
       for (const auto method : record->methods())
-        analyze_function(method, ctx);
+        funcs.push_back(method);
     }
     else if (const auto tu = llvm_cast<const clang::TranslationUnitDecl>(decl))
     {
       for (const auto *sub_decl : tu->decls())
       {
         if (const auto f = llvm_cast<const FunctionDecl>(sub_decl))
-          analyze_function(f, ctx);
+          funcs.push_back(f);
       }
     }
+
+    if (get_solve_jobs() == 1 || funcs.size() < 2 || ctx->getExternalSource())
+    {
+      for (const auto *func : funcs)
+        analyze_function(func, ctx);
+    }
+    else
+      analyze_functions(funcs, ctx);
   }
 
-  template<DataFlowState StateT>
-  auto DataFlowSolver<StateT>::analyze_function(const FunctionDecl *func, clang::ASTContext *ctx) -> void
+  template<DataFlowState StateT, DataFlowDirection Direction>
+  auto DataFlowSolver<StateT, Direction>::should_analyze(const FunctionDecl *func, clang::ASTContext *ctx) const
+      -> bool
   {
     if (!func || !func->hasBody())
-      return;
+      return false;
 
     SourceLocation loc = func->getLocation();
     if (ctx->getSourceManager().isInSystemHeader(loc))
+      return false;
+
+    const auto *analysis_context = get_analysis_context();
+    return !analysis_context || analysis_context->is_changed(func);
+  }
+
+  template<DataFlowState StateT, DataFlowDirection Direction>
+  auto DataFlowSolver<StateT, Direction>::analyze_function(const FunctionDecl *func, clang::ASTContext *ctx) -> void
+  {
+    if (!should_analyze(func, ctx))
       return;
 
-    clang::CFG::BuildOptions cfg_opts;
-    cfg_opts.PruneTriviallyFalseEdges = true;
-    cfg_opts.AddImplicitDtors = true;
-    cfg_opts.AddInitializers = true;
-    cfg_opts.setAllAlwaysAdd();
+    auto *analysis_context = get_analysis_context();
+    CFGCache *cfg_cache = analysis_context ? &analysis_context->get_cfg_cache() : nullptr;
 
-    std::unique_ptr<clang::CFG> cfg = clang::CFG::buildCFG(func, func->getBody(), ctx, cfg_opts);
+    std::unique_ptr<clang::CFG> cfg_storage;
+    const clang::CFG *cfg = get_cfg(cfg_cache, func, ctx, get_cfg_options(), cfg_storage);
     if (!cfg)
       return;
 
-    std::vector<StateT> block_in_states(cfg->getNumBlockIDs());
+    const CFGOrder order(*cfg, Direction);
 
-    std::vector<const CFGBlock *> worklist;
+    Engine engine(*this, *cfg, order, get_state_storage());
+    engine.solve(get_initial_state(), get_limits(), m_stats);
 
-    std::vector<bool> in_worklist_set(cfg->getNumBlockIDs(), false);
-
-    const CFGBlock &entry_block = cfg->getEntry();
-    unsigned entry_id = entry_block.getBlockID();
+    m_engine = &engine;
+    on_function_solved(func);
+    m_engine = nullptr;
+  }
 
-    block_in_states[entry_id] = get_initial_state();
+  template<DataFlowState StateT, DataFlowDirection Direction>
+  auto DataFlowSolver<StateT, Direction>::analyze_functions(Ref<Vec<const FunctionDecl *>> funcs,
+                                                            clang::ASTContext *ctx) -> void
+  {
+    // Functions go through in chunks so only a bounded number of solved engines (and their states) wait for
+    // on_function_solved() at any time.
+    static constexpr size_t CHUNK_SIZE = 256;
 
-    for (const auto *block : *cfg)
+    struct PendingSolve
     {
-      if (block)
-      {
-        worklist.push_back(block);
-        in_worklist_set[block->getBlockID()] = true;
-      }
-    }
-
-    while (!worklist.empty())
+      const FunctionDecl *func{};
+      const clang::CFG *cfg{};
+      std::unique_ptr<clang::CFG> cfg_storage;
+      StateT initial_state;
+      DataFlowStats stats;
+      std::optional<CFGOrder> order;
+      std::optional<Engine> engine;
+    };
+
+    auto *analysis_context = get_analysis_context();
+    CFGCache *cfg_cache = analysis_context ? &analysis_context->get_cfg_cache() : nullptr;
+
+    const auto cfg_options = get_cfg_options();
+    const auto storage = get_state_storage();
+    const auto limits = get_limits();
+    const auto jobs = get_solve_jobs();
+
+    for (size_t chunk_begin = 0; chunk_begin < funcs.size(); chunk_begin += CHUNK_SIZE)
     {
-      const CFGBlock *block = worklist.back();
-      worklist.pop_back();
-      unsigned block_id = block->getBlockID();
-      in_worklist_set[block_id] = false;
-
-      StateT current_state = block_in_states[block_id];
-
-      for (const auto &element : *block)
-      {
-        if (auto cfg_stmt = element.getAs<clang::CFGStmt>())
-        {
-          transfer(cfg_stmt->getStmt(), current_state);
-        }
-        else if (auto cfg_init = element.getAs<CFGInitializer>())
-        {
-          transfer_initializer(cfg_init->getInitializer(), current_state);
-        }
-        else if (auto cfg_dtor = element.getAs<CFGImplicitDtor>())
-        {
-          transfer_implicit_dtor(&*cfg_dtor, current_state);
-        }
-      }
+      const size_t chunk_end = std::min(funcs.size(), chunk_begin + CHUNK_SIZE);
 
-      for (auto it = block->succ_begin(); it != block->succ_end(); ++it)
+      // The AST and the CFG cache aren't thread-safe: build the CFGs here and let the workers only read them (see
+      // get_solve_jobs() for the ASTContext queries that aren't plain reads).
+      Vec<PendingSolve> pending(chunk_end - chunk_begin);
+      size_t count = 0;
+      for (size_t i = chunk_begin; i < chunk_end; ++i)
       {
-        const CFGBlock *succ = *it;
+        if (!should_analyze(funcs[i], ctx))
+          continue;
 
-        if (!succ)
+        auto &solve = pending[count];
+        solve.cfg = get_cfg(cfg_cache, funcs[i], ctx, cfg_options, solve.cfg_storage);
+        if (!solve.cfg)
           continue;
 
-        unsigned succ_id = succ->getBlockID();
-        StateT &succ_in_state = block_in_states[succ_id];
+        solve.func = funcs[i];
+        solve.initial_state = get_initial_state();
+        count++;
+      }
 
-        StateT new_succ_state = merge(succ_in_state, current_state);
+      utils::parallel_for(jobs, count, [&](size_t index, u32 worker) {
+        AU_UNUSED(worker);
 
-        if (!(new_succ_state == succ_in_state))
-        {
-          succ_in_state = std::move(new_succ_state);
+        auto &solve = pending[index];
+        solve.order.emplace(*solve.cfg, Direction);
+        solve.engine.emplace(*this, *solve.cfg, *solve.order, storage);
+        solve.engine->solve(std::move(solve.initial_state), limits, solve.stats);
+      });
 
-          if (!in_worklist_set[succ_id])
-          {
-            worklist.push_back(succ);
-            in_worklist_set[succ_id] = true;
-          }
-        }
+      for (size_t index = 0; index < count; ++index)
+      {
+        auto &solve = pending[index];
+        m_stats += solve.stats;
+
+        m_engine = &*solve.engine;
+        on_function_solved(solve.func);
+        m_engine = nullptr;
       }
     }
   }
-} // namespace ia::fixpoint
\ No newline at end of file
+
+  template<DataFlowState StateT, DataFlowDirection Direction>
+  auto DataFlowSolver<StateT, Direction>::transfer_element(Ref<clang::CFGElement> element, MutRef<StateT> state) -> void
+  {
+    if (auto cfg_stmt = element.getAs<clang::CFGStmt>())
+    {
+      transfer(cfg_stmt->getStmt(), state);
+    }
+    else if (auto cfg_init = element.getAs<CFGInitializer>())
+    {
+      transfer_initializer(cfg_init->getInitializer(), state);
+    }
+    else if (auto cfg_dtor = element.getAs<CFGImplicitDtor>())
+    {
+      transfer_implicit_dtor(&*cfg_dtor, state);
+    }
+  }
+
+  template<DataFlowState StateT, DataFlowDirection Direction>
+  auto DataFlowSolver<StateT, Direction>::get_state_before(const Stmt *stmt) -> std::optional<StateT>
+  {
+    if (!m_engine)
+      return std::nullopt;
+
+    m_replaying = true;
+    auto state = m_engine->get_state_before(stmt);
+    m_replaying = false;
+
+    return state;
+  }
+
+  // Backward data flow (liveness, dead stores, ...): the exit block is seeded with get_initial_state(), states
+  // flow along predecessor edges and every block's elements are transferred last to first. Blocks are handed out
+  // in post-order, so a block is solved after its successors except across loop back edges.
+  template<DataFlowState StateT> using BackwardDataFlowSolver = DataFlowSolver<StateT, DataFlowDirection::Backward>;
+} // namespace ia::fixpoint
@@ -15,7 +15,7 @@
 
 #pragma once
 
-#include <fixpoint/pch.hpp>
+#include <fixpoint/analysis_context.hpp>
 
 namespace ia::fixpoint
 {
@@ -48,6 +48,10 @@ private:
     if (result.SourceManager->isInSystemHeader(loc) || !result.SourceManager->isInMainFile(loc) || !loc.isValid())
       return;
 
+    const auto *analysis_context = get_analysis_context();
+    if (analysis_context && !analysis_context->is_changed(decl))
+      return;
+
     m_last_match_result = &result;
 
     police(decl, loc);
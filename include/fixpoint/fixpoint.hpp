@@ -17,10 +17,15 @@
 
 #include <fixpoint/utils.hpp>
 #include <fixpoint/compile_db.hpp>
+#include <fixpoint/changed_lines.hpp>
 
 #include <fixpoint/ast_visitor.hpp>
+#include <fixpoint/fused_ast_visitor.hpp>
 #include <fixpoint/decl_police.hpp>
 #include <fixpoint/data_flow_solver.hpp>
+#include <fixpoint/static_data_flow_solver.hpp>
+#include <fixpoint/gen_kill_solver.hpp>
+#include <fixpoint/persistent_map.hpp>
 #include <fixpoint/control_flow_visitor.hpp>
 
 namespace ia::fixpoint
@@ -41,10 +46,81 @@ public:
       return m_tasks;
     }
 
+    // Restricts the AST traversal to the top-level declarations of the main file, so matchers never visit the
+    // declarations pulled in from headers. Note that implicit template instantiations of templates declared in
+    // headers are skipped as well.
+    auto set_main_file_only(bool enabled) -> void
+    {
+      m_main_file_only = enabled;
+    }
+
+    [[nodiscard]] auto is_main_file_only() const -> bool
+    {
+      return m_main_file_only;
+    }
+
+    // Lets all ControlFlowVisitor tasks matching a function share a single walk over its CFG: the visitors are
+    // queued while the other tasks keep matching and run, interleaved block by block, once the matchers move on
+    // to the next function. get_match_result() stays valid during the walk.
+    auto set_fuse_control_flow_visitors(bool enabled) -> void
+    {
+      m_fuse_control_flow_visitors = enabled;
+    }
+
+    [[nodiscard]] auto is_fusing_control_flow_visitors() const -> bool
+    {
+      return m_fuse_control_flow_visitors;
+    }
+
 private:
     Vec<Box<IWorkloadTask>> m_tasks;
+    bool m_main_file_only{false};
+    bool m_fuse_control_flow_visitors{false};
   };
 
+  // Lookups in one of the on-disk caches: valid entries used vs. translation units parsed (and stored) instead.
+  struct DiskCacheStats
+  {
+    u32 hits{0};
+    u32 misses{0};
+
+    auto operator+=(const DiskCacheStats &other) -> DiskCacheStats &
+    {
+      hits += other.hits;
+      misses += other.misses;
+      return *this;
+    }
+  };
+
+  struct RunReport
+  {
+    u32 jobs{1};
+    u32 translation_units{0};
+    std::chrono::milliseconds wall_time{};
+
+    // Translation units that failed to compile (or crashed their worker process), in source list order.
+    Vec<String> failed_files;
+
+    // CFGs built vs. served from the per translation unit cache, summed over all translation units.
+    CFGCacheStats cfg_cache;
+
+    // Translation unit parses skipped because none of the tasks passed their prefilters (see
+    // IWorkloadTask::get_path_globs()) or because they don't include a file changed by ToolSettings::diff_file.
+    // Counted once per task when ToolSettings::single_parse is off.
+    u32 skipped_parses{0};
+
+    // Lookups in ToolSettings::result_cache_dir; all zero if the cache is off or a task doesn't opt in.
+    DiskCacheStats result_cache;
+
+    // Lookups in ToolSettings::ast_cache_dir.
+    DiskCacheStats ast_cache;
+  };
+
+  class TaskPrefilter;
+  class ResultCache;
+  class ASTCache;
+  struct WorkloadActionConfig;
+
   class Tool
   {
 public:
@@ -53,10 +129,10 @@ public:
 public:
     static auto create(MutRef<Options> options, Ref<CompileDB> compile_db) -> Result<Box<Tool>>;
 
-    ~Tool() = default;
+    ~Tool();
 
 public:
-    auto run(Ref<Workload> workload) -> Result<void>;
+    auto run(Ref<Workload> workload) -> Result<RunReport>;
 
     static auto set_syntax_error_handler(SyntaxErrorHandlerT handler) -> void
     {
@@ -69,11 +145,62 @@ public:
     }
 
 private:
-    clang::tooling::ClangTool m_clang_tool;
+    struct ExecutionResult
+    {
+      // Indices of the translation units that failed, sorted.
+      Vec<size_t> failed;
+      CFGCacheStats cfg_cache;
+      u32 skipped_parses{0};
+      DiskCacheStats result_cache;
+      DiskCacheStats ast_cache;
+    };
+
+    struct TranslationUnitStats
+    {
+      CFGCacheStats cfg_cache;
+      bool skipped{false};
+      DiskCacheStats result_cache;
+      DiskCacheStats ast_cache;
+    };
+
+    auto run_files(Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks) -> Result<ExecutionResult>;
+    auto run_files_sharded(Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks) -> Result<ExecutionResult>;
+
+    auto run_shard_worker(Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks, Ref<Vec<size_t>> queue, i32 fd)
+        -> void;
+
+    auto run_translation_unit(Ref<String> file, Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks,
+                              std::mutex *match_lock, MutRef<TranslationUnitStats> stats) -> i32;
+
+    // Loads the AST of a single compile command from the AST cache, or parses (and stores) it, and runs the
+    // matchers of `config` over it.
+    auto run_with_ast_cache(MutRef<clang::tooling::ClangTool> clang_tool, Ref<WorkloadActionConfig> config,
+                            Ref<String> file, Ref<CompileCommand> command, MutRef<TranslationUnitStats> stats) -> i32;
+
+    // The compile commands of `file` as the frontend gets them, after the resource directory and PCH adjustments.
+    auto get_command_inputs(Ref<String> file, Ref<Vec<CompileCommand>> commands) -> Vec<String>;
+
+    // Everything besides file contents that the results of `tasks` on `file` depend on, hashed into its cache key.
+    auto get_result_cache_inputs(Ref<String> file, Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks,
+                                 Ref<Vec<CompileCommand>> commands) -> Vec<String>;
+
+private:
+    const CompileDB &m_compile_db;
+    const Vec<String> m_source_paths;
+    clang::tooling::ArgumentsAdjuster m_arguments_adjuster;
+    const ToolSettings m_settings;
+    Box<TaskPrefilter> m_prefilter;
+    std::optional<ChangedLines> m_changed_lines;
+    Box<ResultCache> m_result_cache;
+    Box<ASTCache> m_ast_cache;
+
+    // Whether the tasks of the current run all opt into the result cache.
+    bool m_cache_results{false};
     static SyntaxErrorHandlerT s_syntax_error_handler;
 
 protected:
-    Tool(ForwardRef<clang::tooling::ClangTool> ct);
+    Tool(Ref<CompileDB> compile_db, Ref<Vec<String>> source_paths, Ref<ToolSettings> settings,
+         std::optional<ChangedLines> changed_lines);
   };
 
   template<typename Task> auto Workload::add_task() -> void
@@ -0,0 +1,244 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/ast_visitor.hpp>
+
+#include <array>
+#include <tuple>
+
+namespace ia::fixpoint
+{
+  // Runs several ASTVisitor tasks over a single RecursiveASTVisitor traversal of each translation unit. Every
+  // Visit* event of the walk is handed to each of `Visitors` in list order, resolved at compile time, so adding
+  // visitor tasks no longer adds AST traversals.
+  //
+  // The fused walk is driven by this class: the visitors' own Traverse*() overrides and get_matcher() aren't used,
+  // and the traversal options (shouldVisitImplicitCode() etc.) are the union of the visitors' ones. A visitor
+  // whose Visit* returns false stops receiving events while the others go on; the walk ends once all stopped.
+  // Attribute visits (Visit*Attr) aren't forwarded.
+  template<typename... Visitors>
+  class FusedASTVisitor : public IWorkloadTask, public clang::RecursiveASTVisitor<FusedASTVisitor<Visitors...>>
+  {
+    static_assert(sizeof...(Visitors) > 0);
+    static_assert((std::is_base_of_v<ASTVisitor<Visitors>, Visitors> && ...),
+                  "FusedASTVisitor only takes ASTVisitor tasks");
+
+public:
+    FusedASTVisitor() = default;
+
+    explicit FusedASTVisitor(Visitors... visitors) : m_visitors(std::move(visitors)...)
+    {
+    }
+
+    template<typename VisitorT> [[nodiscard]] auto get_visitor() -> MutRef<VisitorT>
+    {
+      return std::get<VisitorT>(m_visitors);
+    }
+
+    template<typename VisitorT> [[nodiscard]] auto get_visitor() const -> Ref<VisitorT>
+    {
+      return std::get<VisitorT>(m_visitors);
+    }
+
+    [[nodiscard]] auto get_matcher() const -> DeclarationMatcher override
+    {
+      return ast::translationUnitDecl();
+    }
+
+    auto run(Ref<MatchFinder::MatchResult> result) -> void override
+    {
+      const auto *node = result.Nodes.getNodeAs<Decl>("decl");
+      if (!node)
+        return;
+
+      std::apply(
+          [&](auto &...visitors) {
+            ((visitors.m_last_match_result = &result, visitors.set_analysis_context(get_analysis_context())), ...);
+          },
+          m_visitors);
+      m_active.fill(true);
+
+      this->TraverseDecl(const_cast<Decl *>(node));
+
+      std::apply([](auto &...visitors) { (visitors.set_analysis_context(nullptr), ...); }, m_visitors);
+    }
+
+    // Clonable (and shardable) as long as every visitor is; the visitors' results travel separately.
+    [[nodiscard]] auto clone() const -> Box<IWorkloadTask> override
+    {
+      return clone_visitors(std::index_sequence_for<Visitors...>{});
+    }
+
+    auto merge_from(MutRef<IWorkloadTask> other) -> void override
+    {
+      auto &fused = static_cast<FusedASTVisitor &>(other);
+      merge_visitors(fused, std::index_sequence_for<Visitors...>{});
+    }
+
+    [[nodiscard]] auto export_results() const -> String override
+    {
+      // Each visitor's blob, prefixed with its size on a line of its own.
+      String blob;
+      std::apply([&](const auto &...visitors) { ((blob += export_part(visitors.export_results())), ...); }, m_visitors);
+      return blob;
+    }
+
+    auto import_results(LLVM_StringRef data) -> void override
+    {
+      std::apply([&](auto &...visitors) { (visitors.import_results(import_part(data)), ...); }, m_visitors);
+    }
+
+    // Cacheable once every visitor declares a version.
+    [[nodiscard]] auto get_cache_version() const -> String override
+    {
+      return std::apply(
+          [](const auto &...visitors) {
+            if ((visitors.get_cache_version().empty() || ...))
+              return String();
+
+            return (export_part(visitors.get_cache_version()) + ...);
+          },
+          m_visitors);
+    }
+
+    [[nodiscard]] auto needs_header_function_bodies() const -> bool override
+    {
+      return std::apply([](const auto &...visitors) { return (visitors.needs_header_function_bodies() || ...); },
+                        m_visitors);
+    }
+
+    // A translation unit is needed as soon as one visitor needs it, so a visitor without prefilters disables them.
+    [[nodiscard]] auto get_path_globs() const -> Vec<String> override
+    {
+      return merge_prefilters([](const auto &visitor) { return visitor.get_path_globs(); });
+    }
+
+    [[nodiscard]] auto get_required_tokens() const -> Vec<String> override
+    {
+      return merge_prefilters([](const auto &visitor) { return visitor.get_required_tokens(); });
+    }
+
+public:
+    [[nodiscard]] auto shouldVisitTemplateInstantiations() const -> bool
+    {
+      return std::apply([](const auto &...v) { return (v.shouldVisitTemplateInstantiations() || ...); }, m_visitors);
+    }
+
+    [[nodiscard]] auto shouldWalkTypesOfTypeLocs() const -> bool
+    {
+      return std::apply([](const auto &...v) { return (v.shouldWalkTypesOfTypeLocs() || ...); }, m_visitors);
+    }
+
+    [[nodiscard]] auto shouldVisitImplicitCode() const -> bool
+    {
+      return std::apply([](const auto &...v) { return (v.shouldVisitImplicitCode() || ...); }, m_visitors);
+    }
+
+    [[nodiscard]] auto shouldVisitLambdaBody() const -> bool
+    {
+      return std::apply([](const auto &...v) { return (v.shouldVisitLambdaBody() || ...); }, m_visitors);
+    }
+
+#define FIXPOINT_FUSED_VISIT(NAME, NODE)                                                                            \
+  auto Visit##NAME(NODE node) -> bool                                                                               \
+  {                                                                                                                 \
+    return dispatch([&](auto &visitor) { return visitor.Visit##NAME(node); });                                     \
+  }
+
+    FIXPOINT_FUSED_VISIT(Stmt, clang::Stmt *)
+#define STMT(CLASS, PARENT) FIXPOINT_FUSED_VISIT(CLASS, clang::CLASS *)
+#include <clang/AST/StmtNodes.inc>
+
+    FIXPOINT_FUSED_VISIT(Decl, clang::Decl *)
+#define DECL(CLASS, BASE) FIXPOINT_FUSED_VISIT(CLASS##Decl, clang::CLASS##Decl *)
+#include <clang/AST/DeclNodes.inc>
+
+    FIXPOINT_FUSED_VISIT(Type, clang::Type *)
+#define TYPE(CLASS, BASE) FIXPOINT_FUSED_VISIT(CLASS##Type, clang::CLASS##Type *)
+#include <clang/AST/TypeNodes.inc>
+
+    // QualifiedTypeLoc and UnqualTypeLoc aren't listed in TypeNodes.inc, like in RecursiveASTVisitor.
+    FIXPOINT_FUSED_VISIT(TypeLoc, clang::TypeLoc)
+    FIXPOINT_FUSED_VISIT(QualifiedTypeLoc, clang::QualifiedTypeLoc)
+    FIXPOINT_FUSED_VISIT(UnqualTypeLoc, clang::UnqualTypeLoc)
+#define TYPE(CLASS, BASE) FIXPOINT_FUSED_VISIT(CLASS##TypeLoc, clang::CLASS##TypeLoc)
+#include <clang/AST/TypeNodes.inc>
+
+#undef FIXPOINT_FUSED_VISIT
+
+private:
+    // Hands an event to every visitor that hasn't stopped yet. The traversal goes on while any of them is left.
+    template<typename FuncT> auto dispatch(FuncT &&visit) -> bool
+    {
+      bool any_active = false;
+      [&]<size_t... I>(std::index_sequence<I...>) {
+        ((m_active[I] = m_active[I] && visit(std::get<I>(m_visitors)), any_active |= m_active[I]), ...);
+      }(std::index_sequence_for<Visitors...>{});
+      return any_active;
+    }
+
+    template<size_t... I> auto clone_visitors(std::index_sequence<I...>) const -> Box<IWorkloadTask>
+    {
+      std::array<Box<IWorkloadTask>, sizeof...(Visitors)> clones{std::get<I>(m_visitors).clone()...};
+      for (const auto &clone : clones)
+      {
+        if (!clone)
+          return nullptr;
+      }
+
+      return std::make_unique<FusedASTVisitor>(std::move(static_cast<Visitors &>(*clones[I]))...);
+    }
+
+    template<size_t... I> auto merge_visitors(MutRef<FusedASTVisitor> other, std::index_sequence<I...>) -> void
+    {
+      (std::get<I>(m_visitors).merge_from(std::get<I>(other.m_visitors)), ...);
+    }
+
+    template<typename FuncT> auto merge_prefilters(FuncT &&get) const -> Vec<String>
+    {
+      Vec<String> merged;
+      bool unfiltered = false;
+      const auto append = [&](Ref<Vec<String>> values) {
+        unfiltered |= values.empty();
+        merged.insert(merged.end(), values.begin(), values.end());
+      };
+
+      std::apply([&](const auto &...visitors) { (append(get(visitors)), ...); }, m_visitors);
+      return unfiltered ? Vec<String>{} : merged;
+    }
+
+    static auto export_part(Ref<String> part) -> String
+    {
+      return std::format("{}\n{}", part.size(), part);
+    }
+
+    static auto import_part(MutRef<LLVM_StringRef> data) -> LLVM_StringRef
+    {
+      auto [size_line, rest] = data.split('\n');
+
+      size_t size = 0;
+      if (size_line.getAsInteger(10, size))
+        size = rest.size();
+
+      data = rest.drop_front(std::min(size, rest.size()));
+      return rest.take_front(size);
+    }
+
+    std::tuple<Visitors...> m_visitors;
+    std::array<bool, sizeof...(Visitors)> m_active{};
+  };
+} // namespace ia::fixpoint
@@ -0,0 +1,201 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/data_flow_solver.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace ia::fixpoint
+{
+  // A fixed-size set of facts stored as dense 64-bit words. The lattice operations are plain word loops that the
+  // compiler vectorizes.
+  class FactSet
+  {
+public:
+    FactSet() = default;
+
+    explicit FactSet(u32 size, bool value = false) : m_size(size), m_words((size + 63) / 64, value ? ~u64{0} : 0)
+    {
+      clear_unused_bits();
+    }
+
+    [[nodiscard]] auto size() const -> u32
+    {
+      return m_size;
+    }
+
+    [[nodiscard]] auto test(u32 index) const -> bool
+    {
+      return (m_words[index / 64] >> (index % 64)) & 1;
+    }
+
+    auto set(u32 index) -> void
+    {
+      m_words[index / 64] |= u64{1} << (index % 64);
+    }
+
+    auto reset(u32 index) -> void
+    {
+      m_words[index / 64] &= ~(u64{1} << (index % 64));
+    }
+
+    auto clear() -> void
+    {
+      std::ranges::fill(m_words, 0);
+    }
+
+    [[nodiscard]] auto count() const -> u32
+    {
+      Mut<u32> result = 0;
+      for (const auto word : m_words)
+        result += static_cast<u32>(std::popcount(word));
+      return result;
+    }
+
+    // Both return whether this set changed.
+    auto union_with(Ref<FactSet> other) -> bool
+    {
+      Mut<u64> changed = 0;
+      for (size_t i = 0; i < m_words.size(); ++i)
+      {
+        const auto word = m_words[i] | other.m_words[i];
+        changed |= word ^ m_words[i];
+        m_words[i] = word;
+      }
+      return changed != 0;
+    }
+
+    auto intersect_with(Ref<FactSet> other) -> bool
+    {
+      Mut<u64> changed = 0;
+      for (size_t i = 0; i < m_words.size(); ++i)
+      {
+        const auto word = m_words[i] & other.m_words[i];
+        changed |= word ^ m_words[i];
+        m_words[i] = word;
+      }
+      return changed != 0;
+    }
+
+    // Removes every fact of `other` from this set.
+    auto subtract(Ref<FactSet> other) -> void
+    {
+      for (size_t i = 0; i < m_words.size(); ++i)
+        m_words[i] &= ~other.m_words[i];
+    }
+
+    auto operator==(const FactSet &) const -> bool = default;
+
+private:
+    auto clear_unused_bits() -> void
+    {
+      if (m_size % 64)
+        m_words.back() &= (u64{1} << (m_size % 64)) - 1;
+    }
+
+    u32 m_size{0};
+    Vec<u64> m_words;
+  };
+
+  enum class GenKillJoin
+  {
+    // May analyses (e.g. reaching definitions): a fact holds if it holds on any incoming path.
+    Union,
+
+    // Must analyses (e.g. initialized variables): a fact holds only if it holds on every incoming path.
+    Intersection,
+  };
+
+  // Forward data flow over problems whose transfer functions are `out = (in - kill) | gen`. The gen/kill sets of
+  // every statement are folded into one pair per CFG block, so the fixpoint iterations only do word operations on
+  // whole blocks, independent of how many statements a block has. The sets are queried once more when replaying
+  // the blocks for on_statement() instead of being kept per statement, so the gen_kill*() hooks must be pure: the
+  // same element has to yield the same sets both times.
+  class GenKillSolver : public IWorkloadTask
+  {
+public:
+    // Number of facts tracked in `func`. Called before any gen/kill set of the function is queried.
+    [[nodiscard]] virtual auto get_fact_count(const FunctionDecl *func) -> u32 = 0;
+
+    virtual auto gen_kill(const Stmt *stmt, MutRef<FactSet> gen, MutRef<FactSet> kill) -> void = 0;
+
+    virtual auto gen_kill_initializer(const CXXCtorInitializer *init, MutRef<FactSet> gen, MutRef<FactSet> kill)
+        -> void
+    {
+      AU_UNUSED(init);
+      AU_UNUSED(gen);
+      AU_UNUSED(kill);
+    }
+
+    virtual auto gen_kill_implicit_dtor(const CFGImplicitDtor *dtor, MutRef<FactSet> gen, MutRef<FactSet> kill)
+        -> void
+    {
+      AU_UNUSED(dtor);
+      AU_UNUSED(gen);
+      AU_UNUSED(kill);
+    }
+
+    // Called once per statement after the fixpoint is reached, with the facts holding right before it.
+    virtual auto on_statement(const Stmt *stmt, Ref<FactSet> state) -> void
+    {
+      AU_UNUSED(stmt);
+      AU_UNUSED(state);
+    }
+
+    [[nodiscard]] virtual auto get_join() const -> GenKillJoin
+    {
+      return GenKillJoin::Union;
+    }
+
+    // The facts holding on function entry. Empty by default.
+    virtual auto get_entry_state(const FunctionDecl *func, MutRef<FactSet> state) -> void
+    {
+      AU_UNUSED(func);
+      AU_UNUSED(state);
+    }
+
+    [[nodiscard]] virtual auto get_cfg_options() const -> CFGOptions
+    {
+      return {};
+    }
+
+public:
+    auto run(Ref<MatchResult> result) -> void override;
+
+    [[nodiscard]] auto get_stats() const -> Ref<DataFlowStats>
+    {
+      return m_stats;
+    }
+
+protected:
+    auto get_match_result() -> const MatchResult *
+    {
+      return m_last_match_result;
+    }
+
+private:
+    auto analyze_function(const FunctionDecl *func, clang::ASTContext *ctx) -> void;
+
+    // Clears the sets and fills them in for a single CFG element. Returns the element's statement, if it has one.
+    auto gen_kill_element(Ref<clang::CFGElement> element, MutRef<FactSet> gen, MutRef<FactSet> kill)
+        -> const Stmt *;
+
+    const MatchResult *m_last_match_result{};
+    DataFlowStats m_stats;
+  };
+} // namespace ia::fixpoint
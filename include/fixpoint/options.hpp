@@ -19,6 +19,47 @@
 
 namespace ia::fixpoint
 {
+  struct ToolSettings
+  {
+    // Register every task on one MatchFinder so each translation unit is parsed exactly once.
+    bool single_parse{true};
+
+    // Number of translation units analyzed concurrently, 0 picks one per hardware thread.
+    u32 jobs{1};
+
+    // When non-zero, the source list is split into this many shards, each analyzed by a forked worker process.
+    u32 processes{0};
+
+    // How often a translation unit whose worker process crashed is retried before it is reported.
+    u32 crash_retries{1};
+
+    // Record translation units that fail to compile and carry on with the rest, instead of stopping the analysis
+    // on the first error. The failed files are listed in the RunReport.
+    bool keep_going{false};
+
+    // Don't parse the bodies of functions declared outside the main file (unless a task asks for them), which
+    // saves most of the parse time and AST memory spent on inline and template code in headers.
+    bool skip_header_bodies{false};
+
+    // Path prefixes whose function bodies are still parsed when skip_header_bodies is set.
+    Vec<String> header_body_allowlist;
+
+    // Path of a unified diff. When set, only translation units that include a changed file are parsed, and the
+    // data flow solvers, ControlFlowVisitor and DeclPolice tasks only look at the functions and declarations whose
+    // source ranges overlap a changed line.
+    String diff_file;
+
+    // Directory of the persistent result cache. When set (and every task declares a cache version), the results of
+    // a translation unit are stored after it is analyzed and replayed without parsing on later runs, as long as its
+    // command line, the tasks and the contents of every file it includes are unchanged.
+    String result_cache_dir;
+
+    // Directory of the serialized AST cache. When set, every parsed translation unit is saved there and later runs
+    // load it instead of running the frontend, as long as its command line and the contents of every file it
+    // includes are unchanged. The saved ASTs always have all function bodies, so skip_header_bodies is ignored.
+    String ast_cache_dir;
+  };
+
   class Options
   {
 public:
@@ -34,9 +75,20 @@ public:
       return m_cop;
     }
 
+    [[nodiscard]] auto get_settings() -> MutRef<ToolSettings>
+    {
+      return m_settings;
+    }
+
+    [[nodiscard]] auto get_settings() const -> Ref<ToolSettings>
+    {
+      return m_settings;
+    }
+
 private:
     const String m_name;
     clang::tooling::CommonOptionsParser m_cop;
+    ToolSettings m_settings;
 
 protected:
     Options(ForwardRef<clang::tooling::CommonOptionsParser> cop, Ref<String> name);
@@ -17,6 +17,9 @@
 
 #include <crux/crux.hpp>
 
+#include <chrono>
+#include <mutex>
+
 #include <clang/ASTMatchers/ASTMatchFinder.h>
 #include <clang/ASTMatchers/ASTMatchers.h>
 #include <clang/AST/RecursiveASTVisitor.h>
@@ -85,10 +88,86 @@ namespace ia::fixpoint
     return llvm::dyn_cast_or_null<ToT>(v);
   }
 
+  class AnalysisContext;
+
   class IWorkloadTask : public MatchCallback
   {
 public:
     virtual ~IWorkloadTask() = default;
     [[nodiscard]] virtual auto get_matcher() const -> DeclarationMatcher = 0;
+
+    // Opt-in for parallel runs: return a task with the same configuration but none of the accumulated results
+    // (and no state shared with this one). Every translation unit is then analyzed by a private clone instead of
+    // serializing the callbacks of a single shared instance.
+    [[nodiscard]] virtual auto clone() const -> Box<IWorkloadTask>
+    {
+      return nullptr;
+    }
+
+    // Folds the results of a clone created by clone() into this task. Called once per translation unit, always
+    // in source list order, so the reduced results do not depend on the number of jobs.
+    virtual auto merge_from(MutRef<IWorkloadTask> other) -> void
+    {
+      AU_UNUSED(other);
+    }
+
+    // Opt-in for process sharding: serialize the results of a clone so a worker process can ship them to the
+    // parent, where import_results() folds them into the original task (in source list order, like merge_from).
+    [[nodiscard]] virtual auto export_results() const -> String
+    {
+      return {};
+    }
+
+    virtual auto import_results(LLVM_StringRef data) -> void
+    {
+      AU_UNUSED(data);
+    }
+
+    // Opt-in for ToolSettings::result_cache_dir: a version that changes whenever the results of the task for
+    // unchanged sources could change, e.g. a number bumped with every behavior change. Tasks returning one must
+    // implement clone(), export_results() and import_results(); the cache is only used when all tasks opt in.
+    [[nodiscard]] virtual auto get_cache_version() const -> String
+    {
+      return {};
+    }
+
+    // Return true if the task looks into the bodies of functions defined in headers (e.g. for interprocedural
+    // analysis). Any such task in a run disables ToolSettings::skip_header_bodies.
+    [[nodiscard]] virtual auto needs_header_function_bodies() const -> bool
+    {
+      return false;
+    }
+
+    // Optional prefilters, checked before a translation unit is parsed: the task only runs on main files whose
+    // path (as given, or absolute) matches one of these llvm::GlobPattern globs, e.g. "*/src/net/*". The file
+    // isn't parsed at all if no task of the run needs it.
+    [[nodiscard]] virtual auto get_path_globs() const -> Vec<String>
+    {
+      return {};
+    }
+
+    // Optional prefilter: the task only runs on translation units that mention one of these identifiers (e.g.
+    // "function" for std::function) in the main file or in a header it includes from its -I / -iquote directories.
+    // The files are raw lexed, without expanding macros or looking into system headers.
+    [[nodiscard]] virtual auto get_required_tokens() const -> Vec<String>
+    {
+      return {};
+    }
+
+public:
+    // The per translation unit state shared with the other tasks (e.g. the CFG cache). Set by the Tool while the
+    // matchers of a translation unit run, nullptr otherwise.
+    auto set_analysis_context(AnalysisContext *context) -> void
+    {
+      m_analysis_context = context;
+    }
+
+    [[nodiscard]] auto get_analysis_context() const -> AnalysisContext *
+    {
+      return m_analysis_context;
+    }
+
+private:
+    AnalysisContext *m_analysis_context{};
   };
 } // namespace ia::fixpoint
\ No newline at end of file
@@ -0,0 +1,277 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/pch.hpp>
+
+#include <memory>
+
+namespace ia::fixpoint
+{
+  // An immutable-node ordered map for large data flow states: copies share all nodes (O(1)), updates copy only the
+  // path to the changed key, and comparisons skip subtrees the two maps share.
+  //
+  // It is a treap whose node priorities are derived from the key hashes, so a set of keys always has the same tree
+  // shape no matter the order it was built in. That makes a recursive comparison valid and lets join_with() return
+  // the very same nodes when nothing changed.
+  template<typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>, typename LessT = std::less<KeyT>>
+  class PersistentMap
+  {
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node
+    {
+      KeyT key;
+      ValueT value;
+      u64 priority;
+      size_t size;
+      NodePtr left;
+      NodePtr right;
+    };
+
+public:
+    PersistentMap() = default;
+
+    [[nodiscard]] auto size() const -> size_t
+    {
+      return m_root ? m_root->size : 0;
+    }
+
+    [[nodiscard]] auto empty() const -> bool
+    {
+      return !m_root;
+    }
+
+    // Returns nullptr if the key isn't in the map.
+    [[nodiscard]] auto find(Ref<KeyT> key) const -> const ValueT *
+    {
+      const Node *node = m_root.get();
+      while (node)
+      {
+        if (LessT{}(key, node->key))
+          node = node->left.get();
+        else if (LessT{}(node->key, key))
+          node = node->right.get();
+        else
+          return &node->value;
+      }
+      return nullptr;
+    }
+
+    [[nodiscard]] auto contains(Ref<KeyT> key) const -> bool
+    {
+      return find(key) != nullptr;
+    }
+
+    auto set(Ref<KeyT> key, Ref<ValueT> value) -> void
+    {
+      m_root = insert(m_root, key, value, get_priority(key));
+    }
+
+    auto erase(Ref<KeyT> key) -> void
+    {
+      m_root = remove(m_root, key);
+    }
+
+    // Adds the entries of `other`, combining the values of keys present in both maps with
+    // `join(Ref<ValueT> current, Ref<ValueT> incoming) -> ValueT`. Returns whether this map changed.
+    template<typename JoinT> auto join_with(Ref<PersistentMap> other, JoinT &&join) -> bool
+    {
+      auto joined = unite(m_root, other.m_root, join);
+      if (joined == m_root)
+        return false;
+
+      m_root = std::move(joined);
+      return true;
+    }
+
+    // Visits the entries in key order.
+    template<typename VisitorT> auto for_each(VisitorT &&visitor) const -> void
+    {
+      visit(m_root.get(), visitor);
+    }
+
+    auto operator==(const PersistentMap &other) const -> bool
+    {
+      return equal(m_root.get(), other.m_root.get());
+    }
+
+private:
+    static auto get_priority(Ref<KeyT> key) -> u64
+    {
+      // splitmix64 finalizer, so weak hashes (e.g. of pointers) still give balanced trees.
+      Mut<u64> x = static_cast<u64>(HashT{}(key));
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+      return x ^ (x >> 31);
+    }
+
+    // Strict ordering of the heap, with the key breaking priority ties.
+    static auto is_above(u64 priority, Ref<KeyT> key, const Node *node) -> bool
+    {
+      return priority > node->priority || (priority == node->priority && LessT{}(node->key, key));
+    }
+
+    static auto make_node(Ref<KeyT> key, Ref<ValueT> value, u64 priority, NodePtr left, NodePtr right) -> NodePtr
+    {
+      const auto size = 1 + (left ? left->size : 0) + (right ? right->size : 0);
+      return std::make_shared<const Node>(Node{key, value, priority, size, std::move(left), std::move(right)});
+    }
+
+    static auto with_children(const NodePtr &node, NodePtr left, NodePtr right) -> NodePtr
+    {
+      if (left == node->left && right == node->right)
+        return node;
+
+      return make_node(node->key, node->value, node->priority, std::move(left), std::move(right));
+    }
+
+    struct Split
+    {
+      NodePtr less;
+      const Node *match{};
+      NodePtr greater;
+    };
+
+    static auto split(const NodePtr &node, Ref<KeyT> key) -> Split
+    {
+      if (!node)
+        return {};
+
+      if (LessT{}(key, node->key))
+      {
+        auto [less, match, greater] = split(node->left, key);
+        return {std::move(less), match, with_children(node, std::move(greater), node->right)};
+      }
+
+      if (LessT{}(node->key, key))
+      {
+        auto [less, match, greater] = split(node->right, key);
+        return {with_children(node, node->left, std::move(less)), match, std::move(greater)};
+      }
+
+      return {node->left, node.get(), node->right};
+    }
+
+    // Every key in `left` is less than every key in `right`.
+    static auto concat(const NodePtr &left, const NodePtr &right) -> NodePtr
+    {
+      if (!left)
+        return right;
+      if (!right)
+        return left;
+
+      if (is_above(left->priority, left->key, right.get()))
+        return with_children(left, left->left, concat(left->right, right));
+
+      return with_children(right, concat(left, right->left), right->right);
+    }
+
+    static auto insert(const NodePtr &node, Ref<KeyT> key, Ref<ValueT> value, u64 priority) -> NodePtr
+    {
+      if (!node || is_above(priority, key, node.get()))
+      {
+        auto [less, match, greater] = split(node, key);
+        AU_UNUSED(match);
+        return make_node(key, value, priority, std::move(less), std::move(greater));
+      }
+
+      if (LessT{}(key, node->key))
+        return with_children(node, insert(node->left, key, value, priority), node->right);
+
+      if (LessT{}(node->key, key))
+        return with_children(node, node->left, insert(node->right, key, value, priority));
+
+      if (node->value == value)
+        return node;
+
+      return make_node(key, value, priority, node->left, node->right);
+    }
+
+    static auto remove(const NodePtr &node, Ref<KeyT> key) -> NodePtr
+    {
+      if (!node)
+        return node;
+
+      if (LessT{}(key, node->key))
+        return with_children(node, remove(node->left, key), node->right);
+
+      if (LessT{}(node->key, key))
+        return with_children(node, node->left, remove(node->right, key));
+
+      return concat(node->left, node->right);
+    }
+
+    // Returns `current` itself (not a copy) if `incoming` adds nothing to it.
+    template<typename JoinT>
+    static auto unite(const NodePtr &current, const NodePtr &incoming, JoinT &join) -> NodePtr
+    {
+      if (current == incoming || !incoming)
+        return current;
+      if (!current)
+        return incoming;
+
+      if (!is_above(incoming->priority, incoming->key, current.get()))
+      {
+        auto [less, match, greater] = split(incoming, current->key);
+
+        auto left = unite(current->left, less, join);
+        auto right = unite(current->right, greater, join);
+
+        if (!match)
+          return with_children(current, std::move(left), std::move(right));
+
+        ValueT value = join(current->value, match->value);
+        if (value == current->value)
+          return with_children(current, std::move(left), std::move(right));
+
+        return make_node(current->key, value, current->priority, std::move(left), std::move(right));
+      }
+
+      // The incoming root strictly outranks every node of `current`, so its key can't be in `current`.
+      auto [less, match, greater] = split(current, incoming->key);
+      AU_UNUSED(match);
+
+      return make_node(incoming->key, incoming->value, incoming->priority, unite(less, incoming->left, join),
+                       unite(greater, incoming->right, join));
+    }
+
+    template<typename VisitorT> static auto visit(const Node *node, VisitorT &visitor) -> void
+    {
+      if (!node)
+        return;
+
+      visit(node->left.get(), visitor);
+      visitor(node->key, node->value);
+      visit(node->right.get(), visitor);
+    }
+
+    static auto equal(const Node *a, const Node *b) -> bool
+    {
+      if (a == b)
+        return true;
+      if (!a || !b || a->size != b->size)
+        return false;
+
+      // Equal key sets have equal shapes, so the nodes line up one to one.
+      return !LessT{}(a->key, b->key) && !LessT{}(b->key, a->key) && a->value == b->value &&
+             equal(a->left.get(), b->left.get()) && equal(a->right.get(), b->right.get());
+    }
+
+    NodePtr m_root;
+  };
+} // namespace ia::fixpoint
@@ -0,0 +1,259 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/data_flow_engine.hpp>
+
+namespace ia::fixpoint
+{
+  // DataFlowSolver without virtual calls: `Derived` provides the hooks as public members, resolved at compile time.
+  //
+  // Required:
+  //   merge(Ref<StateT> current, Ref<StateT> incoming) -> StateT
+  //   get_initial_state() -> StateT
+  // Optional:
+  //   join_into(MutRef<StateT> target, Ref<StateT> incoming) -> bool
+  //   widen_into(MutRef<StateT> target, Ref<StateT> incoming) -> bool
+  //   narrow_into(MutRef<StateT> target, Ref<StateT> recomputed) -> bool
+  //   get_fallback_state() -> StateT
+  //   transfer(const T *stmt, MutRef<StateT> state) for any Stmt class T (e.g. BinaryOperator, CallExpr, Stmt)
+  //   transfer_initializer(const CXXCtorInitializer *init, MutRef<StateT> state)
+  //   transfer_implicit_dtor(const CFGImplicitDtor *dtor, MutRef<StateT> state)
+  //
+  // Statements are dispatched with a switch on their class, like RecursiveASTVisitor does, to the most specific
+  // transfer() overload; statements no overload accepts are skipped. Like in DataFlowSolver, get_cfg_options(),
+  // get_state_storage(), get_limits() and on_function_solved() can be redefined by `Derived`, and `Direction`
+  // selects a forward or backward solve.
+  template<typename Derived, DataFlowState StateT, DataFlowDirection Direction = DataFlowDirection::Forward>
+  class StaticDataFlowSolver : public IWorkloadTask
+  {
+public:
+    [[nodiscard]] auto get_cfg_options() const -> CFGOptions
+    {
+      return {};
+    }
+
+    [[nodiscard]] auto get_state_storage() const -> StateStorage
+    {
+      return StateStorage::AllBlocks;
+    }
+
+    [[nodiscard]] auto get_limits() const -> DataFlowLimits
+    {
+      return {};
+    }
+
+    auto on_function_solved(const FunctionDecl *func) -> void
+    {
+      AU_UNUSED(func);
+    }
+
+public:
+    auto run(Ref<MatchResult> result) -> void override;
+
+    [[nodiscard]] auto get_stats() const -> Ref<DataFlowStats>
+    {
+      return m_stats;
+    }
+
+protected:
+    auto get_match_result() -> const MatchResult *
+    {
+      return m_last_match_result;
+    }
+
+    // See DataFlowSolver::get_state_before().
+    auto get_state_before(const Stmt *stmt) -> std::optional<StateT>;
+
+    [[nodiscard]] auto is_replaying() const -> bool
+    {
+      return m_replaying;
+    }
+
+private:
+    // The engine's view of `Derived`, filling in the optional hooks.
+    struct Hooks
+    {
+      Derived &derived;
+
+      auto join_into(MutRef<StateT> target, Ref<StateT> incoming) -> bool
+      {
+        if constexpr (requires { derived.join_into(target, incoming); })
+          return derived.join_into(target, incoming);
+        else
+        {
+          StateT merged = derived.merge(target, incoming);
+          if (merged == target)
+            return false;
+
+          target = std::move(merged);
+          return true;
+        }
+      }
+
+      auto widen_into(MutRef<StateT> target, Ref<StateT> incoming) -> bool
+      {
+        if constexpr (requires { derived.widen_into(target, incoming); })
+          return derived.widen_into(target, incoming);
+        else
+          return join_into(target, incoming);
+      }
+
+      auto narrow_into(MutRef<StateT> target, Ref<StateT> recomputed) -> bool
+      {
+        if constexpr (requires { derived.narrow_into(target, recomputed); })
+          return derived.narrow_into(target, recomputed);
+        else
+        {
+          if (target == recomputed)
+            return false;
+
+          target = recomputed;
+          return true;
+        }
+      }
+
+      auto get_fallback_state() -> StateT
+      {
+        if constexpr (requires { derived.get_fallback_state(); })
+          return derived.get_fallback_state();
+        else
+          return derived.get_initial_state();
+      }
+
+      auto transfer_element(Ref<clang::CFGElement> element, MutRef<StateT> state) -> void
+      {
+        if (auto cfg_stmt = element.getAs<clang::CFGStmt>())
+          transfer_stmt(cfg_stmt->getStmt(), state);
+        else if (auto cfg_init = element.getAs<CFGInitializer>())
+        {
+          if constexpr (requires { derived.transfer_initializer(cfg_init->getInitializer(), state); })
+            derived.transfer_initializer(cfg_init->getInitializer(), state);
+        }
+        else if (auto cfg_dtor = element.getAs<CFGImplicitDtor>())
+        {
+          if constexpr (requires { derived.transfer_implicit_dtor(&*cfg_dtor, state); })
+            derived.transfer_implicit_dtor(&*cfg_dtor, state);
+        }
+      }
+
+      auto transfer_stmt(const Stmt *stmt, MutRef<StateT> state) -> void
+      {
+        switch (stmt->getStmtClass())
+        {
+#define ABSTRACT_STMT(STMT)
+#define STMT(CLASS, PARENT)                                                                                         \
+  case Stmt::CLASS##Class:                                                                                          \
+    if constexpr (requires { derived.transfer(static_cast<const clang::CLASS *>(stmt), state); })                   \
+      derived.transfer(static_cast<const clang::CLASS *>(stmt), state);                                             \
+    break;
+#include <clang/AST/StmtNodes.inc>
+
+        default:
+          break;
+        }
+      }
+    };
+
+    using Engine = DataFlowEngine<StateT, Hooks, Direction>;
+
+    auto derived() -> MutRef<Derived>
+    {
+      return static_cast<Derived &>(*this);
+    }
+
+    auto analyze_function(const FunctionDecl *func, clang::ASTContext *ctx) -> void;
+
+    const MatchResult *m_last_match_result{};
+    DataFlowStats m_stats;
+    Engine *m_engine{};
+    bool m_replaying{false};
+  };
+
+  template<typename Derived, DataFlowState StateT, DataFlowDirection Direction>
+  auto StaticDataFlowSolver<Derived, StateT, Direction>::run(Ref<MatchResult> result) -> void
+  {
+    const auto *decl = result.Nodes.getNodeAs<Decl>("decl");
+    if (!decl)
+      return;
+
+    m_last_match_result = &result;
+
+    auto *ctx = result.Context;
+
+    if (const auto func = llvm_cast<const FunctionDecl>(decl))
+      analyze_function(func, ctx);
+    else if (const auto record = llvm_cast<const CXXRecordDecl>(decl))
+    {
+      for (const auto method : record->methods())
+        analyze_function(method, ctx);
+    }
+    else if (const auto tu = llvm_cast<const clang::TranslationUnitDecl>(decl))
+    {
+      for (const auto *sub_decl : tu->decls())
+      {
+        if (const auto f = llvm_cast<const FunctionDecl>(sub_decl))
+          analyze_function(f, ctx);
+      }
+    }
+  }
+
+  template<typename Derived, DataFlowState StateT, DataFlowDirection Direction>
+  auto StaticDataFlowSolver<Derived, StateT, Direction>::analyze_function(const FunctionDecl *func,
+                                                                          clang::ASTContext *ctx) -> void
+  {
+    if (!func || !func->hasBody())
+      return;
+
+    const SourceLocation loc = func->getLocation();
+    if (ctx->getSourceManager().isInSystemHeader(loc))
+      return;
+
+    auto *const analysis_context = get_analysis_context();
+    if (analysis_context && !analysis_context->is_changed(func))
+      return;
+
+    CFGCache *const cfg_cache = analysis_context ? &analysis_context->get_cfg_cache() : nullptr;
+
+    std::unique_ptr<clang::CFG> cfg_storage;
+    const clang::CFG *cfg = get_cfg(cfg_cache, func, ctx, derived().get_cfg_options(), cfg_storage);
+    if (!cfg)
+      return;
+
+    const CFGOrder order(*cfg, Direction);
+
+    Hooks hooks{derived()};
+    Engine engine(hooks, *cfg, order, derived().get_state_storage());
+    engine.solve(derived().get_initial_state(), derived().get_limits(), m_stats);
+
+    m_engine = &engine;
+    derived().on_function_solved(func);
+    m_engine = nullptr;
+  }
+
+  template<typename Derived, DataFlowState StateT, DataFlowDirection Direction>
+  auto StaticDataFlowSolver<Derived, StateT, Direction>::get_state_before(const Stmt *stmt) -> std::optional<StateT>
+  {
+    if (!m_engine)
+      return std::nullopt;
+
+    m_replaying = true;
+    auto state = m_engine->get_state_before(stmt);
+    m_replaying = false;
+
+    return state;
+  }
+} // namespace ia::fixpoint
@@ -27,6 +27,7 @@ namespace ia::fixpoint
     [[nodiscard]] auto get_decl_str_start_and_end_cols(const CXXRecordDecl *decl) -> String;
     [[nodiscard]] auto get_ref_str_start_and_end_cols(const fixpoint::DeclRefExpr *ref) -> String;
 
+    // Both query (and fill) the ASTContext's type info caches, so they must not run on concurrent solver threads.
     [[nodiscard]] auto fits_in_register(const VarDecl *decl) -> bool;
     [[nodiscard]] auto is_cheap_to_copy(const VarDecl *decl) -> bool;
     [[nodiscard]] auto is_std_class(QualType type, const char *class_name) -> bool;
@@ -46,5 +47,12 @@ namespace ia::fixpoint
     {
       return is_std_class(type, "function");
     }
+
+    // Resolves a requested job count, where 0 means one job per hardware thread.
+    [[nodiscard]] auto get_worker_count(u32 jobs) -> u32;
+
+    // Calls body(index, worker) for every index in [0, count) from up to `jobs` worker threads. Workers pull
+    // the next index off a shared cursor, so a few slow items never leave the other workers idle.
+    auto parallel_for(u32 jobs, size_t count, Ref<std::function<void(size_t index, u32 worker)>> body) -> void;
   } // namespace utils
 } // namespace ia::fixpoint
\ No newline at end of file
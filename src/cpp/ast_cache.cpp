@@ -0,0 +1,95 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ast_cache.hpp>
+
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Lex/HeaderSearchOptions.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+namespace ia::fixpoint
+{
+  ASTCache::ASTCache(Ref<String> directory) : m_directory(directory), m_manifests(directory)
+  {
+  }
+
+  auto ASTCache::get_dependencies(Ref<clang::ASTUnit> unit) -> Vec<String>
+  {
+    const auto &sm = unit.getSourceManager();
+    auto &file_manager = sm.getFileManager();
+
+    Mut<Vec<String>> dependencies;
+    for (const auto &entry : llvm::make_range(sm.fileinfo_begin(), sm.fileinfo_end()))
+    {
+      Mut<llvm::SmallString<256>> path(entry.first.getName());
+      file_manager.makeAbsolutePath(path);
+      llvm::sys::path::remove_dots(path, true);
+      dependencies.push_back(String(path.str()));
+    }
+
+    // FileInfos is a hash map; keep manifests stable across runs.
+    std::ranges::sort(dependencies);
+    return dependencies;
+  }
+
+  auto ASTCache::load(Ref<String> key, Ref<String> working_dir, MutRef<Vec<String>> dependencies)
+      -> std::unique_ptr<clang::ASTUnit>
+  {
+    auto manifest = m_manifests.lookup(key);
+    if (!manifest)
+      return nullptr;
+
+    const auto ast_path = get_ast_path(key);
+    if (!llvm::sys::fs::exists(ast_path))
+      return nullptr;
+
+    auto diagnostic_options = std::make_shared<clang::DiagnosticOptions>();
+    auto diagnostics = clang::CompilerInstance::createDiagnostics(
+        *llvm::vfs::getRealFileSystem(), *diagnostic_options, new clang::IgnoringDiagConsumer());
+
+    Mut<clang::FileSystemOptions> file_system_options;
+    file_system_options.WorkingDir = working_dir;
+
+    // The reader checks the input files on its own too; the ASTs are written with content hashes, so a file that
+    // was only touched (as the manifest already verified) doesn't fail the load.
+    Mut<clang::HeaderSearchOptions> header_search_options;
+    header_search_options.ValidateASTInputFilesContent = true;
+
+    auto unit = clang::ASTUnit::LoadFromASTFile(ast_path, m_pch_operations.getRawReader(),
+                                                clang::ASTUnit::LoadEverything, diagnostic_options, diagnostics,
+                                                file_system_options, header_search_options);
+    if (unit)
+      dependencies = std::move(manifest->dependencies);
+
+    return unit;
+  }
+
+  auto ASTCache::store(Ref<String> key, Ref<Vec<String>> dependencies, MutRef<clang::ASTUnit> unit) -> void
+  {
+    // The AST goes first (Save() writes through a temporary file), so a valid manifest always has its AST.
+    if (unit.Save(get_ast_path(key)))
+      return;
+
+    m_manifests.store(key, dependencies, {});
+  }
+
+  auto ASTCache::get_ast_path(Ref<String> key) const -> String
+  {
+    Mut<llvm::SmallString<256>> path(m_directory);
+    llvm::sys::path::append(path, key + ".ast");
+    return String(path.str());
+  }
+} // namespace ia::fixpoint
@@ -0,0 +1,71 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fixpoint/cfg_cache.hpp>
+
+namespace ia::fixpoint
+{
+  auto CFGOptions::to_build_options() const -> clang::CFG::BuildOptions
+  {
+    Mut<clang::CFG::BuildOptions> cfg_opts;
+    cfg_opts.PruneTriviallyFalseEdges = prune_trivially_false_edges;
+    cfg_opts.AddImplicitDtors = add_implicit_dtors;
+    cfg_opts.AddInitializers = add_initializers;
+
+    if (granularity == CFGGranularity::AllExpressions)
+    {
+      cfg_opts.setAllAlwaysAdd();
+      return cfg_opts;
+    }
+
+    for (size_t stmt_class = 0; stmt_class < stmt_classes.size(); ++stmt_class)
+    {
+      if (stmt_classes.test(stmt_class))
+        cfg_opts.setAlwaysAdd(static_cast<clang::Stmt::StmtClass>(stmt_class));
+    }
+
+    return cfg_opts;
+  }
+
+  auto CFGCache::get(const FunctionDecl *func, clang::ASTContext *ctx, Ref<CFGOptions> options) -> const clang::CFG *
+  {
+    auto options_it = std::ranges::find(m_options, options);
+    if (options_it == m_options.end())
+      options_it = m_options.insert(m_options.end(), options);
+
+    const auto options_index = static_cast<u32>(options_it - m_options.begin());
+
+    auto [it, inserted] = m_cfgs.try_emplace({func, options_index});
+    if (!inserted)
+    {
+      m_stats.hits++;
+      return it->second.get();
+    }
+
+    m_stats.builds++;
+    it->second = clang::CFG::buildCFG(func, func->getBody(), ctx, options.to_build_options());
+    return it->second.get();
+  }
+
+  auto get_cfg(CFGCache *cache, const FunctionDecl *func, clang::ASTContext *ctx, Ref<CFGOptions> options,
+               MutRef<std::unique_ptr<clang::CFG>> storage) -> const clang::CFG *
+  {
+    if (cache)
+      return cache->get(func, ctx, options);
+
+    storage = clang::CFG::buildCFG(func, func->getBody(), ctx, options.to_build_options());
+    return storage.get();
+  }
+} // namespace ia::fixpoint
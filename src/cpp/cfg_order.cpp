@@ -0,0 +1,95 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fixpoint/cfg_order.hpp>
+
+#include <limits>
+
+namespace ia::fixpoint
+{
+  static constexpr u32 UNVISITED = std::numeric_limits<u32>::max();
+
+  CFGOrder::CFGOrder(Ref<clang::CFG> cfg, DataFlowDirection direction)
+      : m_indices(cfg.getNumBlockIDs(), UNVISITED)
+  {
+    Mut<Vec<const CFGBlock *>> post_order;
+    Mut<Vec<bool>> seen(cfg.getNumBlockIDs(), false);
+
+    // Iterative DFS: each frame is a block and the position of the next successor to look at.
+    Mut<Vec<std::pair<const CFGBlock *, clang::CFGBlock::const_succ_iterator>>> stack;
+
+    const CFGBlock *entry = &cfg.getEntry();
+    seen[entry->getBlockID()] = true;
+    stack.emplace_back(entry, entry->succ_begin());
+
+    while (!stack.empty())
+    {
+      auto &[block, next] = stack.back();
+      if (next == block->succ_end())
+      {
+        post_order.push_back(block);
+        stack.pop_back();
+        continue;
+      }
+
+      const CFGBlock *succ = *next++;
+      if (succ && !seen[succ->getBlockID()])
+      {
+        seen[succ->getBlockID()] = true;
+        stack.emplace_back(succ, succ->succ_begin());
+      }
+    }
+
+    if (direction == DataFlowDirection::Forward)
+      m_blocks.assign(post_order.rbegin(), post_order.rend());
+    else
+      m_blocks = std::move(post_order);
+
+    for (const auto *block : cfg)
+    {
+      if (block && !seen[block->getBlockID()])
+        m_blocks.push_back(block);
+    }
+
+    for (u32 i = 0; i < m_blocks.size(); ++i)
+      m_indices[m_blocks[i]->getBlockID()] = i;
+  }
+
+  CFGWorklist::CFGWorklist(Ref<CFGOrder> order) : m_order(order), m_queued(order.get_blocks().size(), false)
+  {
+  }
+
+  auto CFGWorklist::push(const CFGBlock *block) -> void
+  {
+    const auto index = m_order.get_index(block);
+    if (m_queued[index])
+      return;
+
+    m_queued[index] = true;
+    m_queue.push(index);
+  }
+
+  auto CFGWorklist::pop() -> const CFGBlock *
+  {
+    if (m_queue.empty())
+      return nullptr;
+
+    const auto index = m_queue.top();
+    m_queue.pop();
+    m_queued[index] = false;
+
+    return m_order.get_blocks()[index];
+  }
+} // namespace ia::fixpoint
@@ -0,0 +1,217 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fixpoint/changed_lines.hpp>
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+
+#include <optional>
+
+namespace ia::fixpoint
+{
+  // Parses the "start[,count]" of one side of a hunk header; the count defaults to 1.
+  static auto parse_hunk_range(LLVM_StringRef text, MutRef<u32> start, MutRef<u32> count) -> bool
+  {
+    const auto [first, length] = text.split(',');
+    if (first.getAsInteger(10, start))
+      return false;
+
+    count = 1;
+    return !text.contains(',') || !length.getAsInteger(10, count);
+  }
+
+  auto ChangedLines::parse(LLVM_StringRef diff) -> Result<ChangedLines>
+  {
+    Mut<ChangedLines> changed;
+
+    // The file the current hunks apply to, or std::nullopt for deleted files (whose new side is /dev/null).
+    Mut<std::optional<size_t>> file;
+    Mut<bool> has_file = false;
+
+    // Lines of the current hunk left to read on each side, and the new side line number of the next line.
+    Mut<u32> old_left = 0;
+    Mut<u32> new_left = 0;
+    Mut<u32> new_line = 0;
+
+    // Removed lines not (yet) replaced by added ones.
+    Mut<bool> deletion = false;
+
+    const auto mark = [&](u32 first, u32 last) {
+      if (file && last)
+        changed.m_files[*file].ranges.emplace_back(std::max<u32>(first, 1), last);
+    };
+
+    Mut<LLVM_StringRef> rest = diff;
+    while (!rest.empty())
+    {
+      auto [line, next] = rest.split('\n');
+      rest = next;
+      line = line.rtrim('\r');
+
+      // Hunk bodies are consumed by count, so removed lines like "--- x" can't be mistaken for file headers.
+      if (old_left || new_left)
+      {
+        if (line.starts_with("+"))
+        {
+          mark(new_line, new_line);
+          new_line++;
+          new_left -= new_left ? 1 : 0;
+          deletion = false;
+        }
+        else if (line.starts_with("-"))
+        {
+          old_left -= old_left ? 1 : 0;
+          deletion = true;
+        }
+        else if (!line.starts_with("\\"))
+        {
+          // Context; "\ No newline at end of file" doesn't count as a line.
+          if (deletion)
+            mark(new_line - 1, new_line);
+
+          new_line++;
+          old_left -= old_left ? 1 : 0;
+          new_left -= new_left ? 1 : 0;
+          deletion = false;
+        }
+
+        // A pure deletion marks the lines on both sides of it.
+        if (deletion && !old_left && !new_left)
+        {
+          mark(new_line - 1, new_line);
+          deletion = false;
+        }
+        continue;
+      }
+
+      if (line.starts_with("+++ "))
+      {
+        auto path = line.drop_front(4).take_until([](char c) { return c == '\t'; }).rtrim();
+        has_file = true;
+
+        if (path == "/dev/null")
+        {
+          file = std::nullopt;
+          continue;
+        }
+
+        // git's default destination prefix.
+        if (path.starts_with("b/"))
+          path = path.drop_front(2);
+
+        const auto normalized = llvm::sys::path::convert_to_slash(path);
+        const auto it = std::ranges::find_if(changed.m_files,
+                                             [&](Ref<ChangedFile> entry) { return entry.path == normalized; });
+        file = static_cast<size_t>(it - changed.m_files.begin());
+        if (it == changed.m_files.end())
+          changed.m_files.push_back({normalized, {}});
+      }
+      else if (line.starts_with("@@ "))
+      {
+        // "@@ -old_start[,old_count] +new_start[,new_count] @@ [section]"
+        const auto [old_range, after_old] = line.drop_front(3).split(' ');
+        const auto new_range = after_old.split(' ').first;
+
+        Mut<u32> old_start = 0;
+        Mut<u32> new_start = 0;
+        if (!old_range.starts_with("-") || !new_range.starts_with("+") ||
+            !parse_hunk_range(old_range.drop_front(), old_start, old_left) ||
+            !parse_hunk_range(new_range.drop_front(), new_start, new_left))
+          return fail("Malformed hunk header in diff: '{}'", line);
+
+        if (!has_file)
+          return fail("Hunk without a file header in diff: '{}'", line);
+
+        new_line = new_start;
+      }
+    }
+
+    for (auto &entry : changed.m_files)
+    {
+      auto &ranges = entry.ranges;
+      std::ranges::sort(ranges);
+
+      Mut<size_t> merged = 0;
+      for (size_t i = 0; i < ranges.size(); ++i)
+      {
+        if (merged && ranges[i].first <= ranges[merged - 1].second + 1)
+          ranges[merged - 1].second = std::max(ranges[merged - 1].second, ranges[i].second);
+        else
+          ranges[merged++] = ranges[i];
+      }
+      ranges.resize(merged);
+    }
+
+    return changed;
+  }
+
+  auto ChangedLines::load(Ref<String> path) -> Result<ChangedLines>
+  {
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (!buffer)
+      return fail("Failed to read diff '{}': {}", path, buffer.getError().message());
+
+    auto changed = parse((*buffer)->getBuffer());
+    if (!changed)
+      return fail("{}: {}", path, changed.error());
+
+    return changed;
+  }
+
+  auto ChangedLines::contains_file(LLVM_StringRef path) const -> bool
+  {
+    return find_file(path) != nullptr;
+  }
+
+  auto ChangedLines::overlaps(LLVM_StringRef path, u32 first_line, u32 last_line) const -> bool
+  {
+    const auto *const file = find_file(path);
+    if (!file)
+      return false;
+
+    // The first range that doesn't end before `first_line`.
+    const auto it = std::ranges::lower_bound(file->ranges, first_line, {},
+                                             [](Ref<std::pair<u32, u32>> range) { return range.second; });
+    return it != file->ranges.end() && it->first <= last_line;
+  }
+
+  auto ChangedLines::overlaps(const Decl *decl) const -> bool
+  {
+    const auto &sm = decl->getASTContext().getSourceManager();
+    const auto range = sm.getExpansionRange(decl->getSourceRange());
+    if (range.getBegin().isInvalid())
+      return false;
+
+    const auto end = range.getEnd().isValid() ? range.getEnd() : range.getBegin();
+    return overlaps(sm.getFilename(range.getBegin()), sm.getExpansionLineNumber(range.getBegin()),
+                    sm.getExpansionLineNumber(end));
+  }
+
+  auto ChangedLines::find_file(LLVM_StringRef path) const -> const ChangedFile *
+  {
+    const auto normalized = llvm::sys::path::convert_to_slash(path);
+    const LLVM_StringRef candidate = normalized;
+
+    for (const auto &file : m_files)
+    {
+      if (candidate == file.path ||
+          (candidate.ends_with(file.path) && candidate.drop_back(file.path.size()).ends_with("/")))
+        return &file;
+    }
+
+    return nullptr;
+  }
+} // namespace ia::fixpoint
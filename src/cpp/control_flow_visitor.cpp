@@ -31,33 +31,55 @@ namespace ia::fixpoint
     if (!func || !ctx || !func->hasBody())
       return;
 
+    auto *const analysis_context = get_analysis_context();
+    if (analysis_context && !analysis_context->is_changed(func))
+      return;
+
+    if (auto *const batch = analysis_context ? analysis_context->get_control_flow_batch() : nullptr)
+    {
+      batch->add(this, func, result);
+      return;
+    }
+
     m_last_match_result = &result;
 
-    Mut<clang::CFG::BuildOptions> cfg_opts;
-    cfg_opts.PruneTriviallyFalseEdges = true;
-    cfg_opts.AddImplicitDtors = true;
-    cfg_opts.setAllAlwaysAdd();
-    cfg_opts.AddInitializers = true;
+    CFGCache *const cfg_cache = analysis_context ? &analysis_context->get_cfg_cache() : nullptr;
 
-    const auto cfg = clang::CFG::buildCFG(func, func->getBody(), ctx, cfg_opts);
+    Mut<std::unique_ptr<clang::CFG>> cfg_storage;
+    const auto *const cfg = get_cfg(cfg_cache, func, ctx, get_cfg_options(), cfg_storage);
     if (!cfg)
       return;
 
-    for (const auto *const block : *cfg)
+    walk(*cfg, {this});
+  }
+
+  auto ControlFlowVisitor::walk(Ref<clang::CFG> cfg, Ref<Vec<ControlFlowVisitor *>> visitors) -> void
+  {
+    for (const auto *const block : cfg)
     {
       if (!block)
         continue;
 
-      on_enter_block(block);
+      for (auto *const visitor : visitors)
+        visitor->on_enter_block(block);
 
       for (const auto &element : *block)
       {
         if (const auto cfg_init = element.getAs<CFGInitializer>())
-          on_initializer(cfg_init->getInitializer());
+        {
+          for (auto *const visitor : visitors)
+            visitor->on_initializer(cfg_init->getInitializer());
+        }
         else if (const auto cfg_dtor = element.getAs<CFGImplicitDtor>())
-          on_implicit_dtor(&*cfg_dtor);
+        {
+          for (auto *const visitor : visitors)
+            visitor->on_implicit_dtor(&*cfg_dtor);
+        }
         else if (const auto cfg_stmt = element.getAs<clang::CFGStmt>())
-          on_statement(cfg_stmt->getStmt());
+        {
+          for (auto *const visitor : visitors)
+            visitor->on_statement(cfg_stmt->getStmt());
+        }
       }
 
       const Stmt *const terminator = block->getTerminatorStmt();
@@ -65,7 +87,10 @@ namespace ia::fixpoint
       if (!terminator && block->succ_size() == 1)
       {
         if (*block->succ_begin())
-          on_simple_jump(nullptr, *block->succ_begin());
+        {
+          for (auto *const visitor : visitors)
+            visitor->on_simple_jump(nullptr, *block->succ_begin());
+        }
       }
       else if (terminator)
       {
@@ -78,7 +103,8 @@ namespace ia::fixpoint
           {
             const CFGBlock *const false_blk = *(block->succ_begin());
             const CFGBlock *const true_blk = *(block->succ_begin() + 1);
-            on_conditional_branch(terminator, true_blk, false_blk);
+            for (auto *const visitor : visitors)
+              visitor->on_conditional_branch(terminator, true_blk, false_blk);
           }
           break;
         }
@@ -91,7 +117,8 @@ namespace ia::fixpoint
           {
             const CFGBlock *const exit_blk = *(block->succ_begin());
             const CFGBlock *const body_blk = *(block->succ_begin() + 1);
-            on_loop_decision(terminator, body_blk, exit_blk);
+            for (auto *const visitor : visitors)
+              visitor->on_loop_decision(terminator, body_blk, exit_blk);
           }
           break;
         }
@@ -99,7 +126,8 @@ namespace ia::fixpoint
         case Stmt::SwitchStmtClass: {
           if (const auto *const sw = llvm_cast<SwitchStmt>(terminator))
           {
-            on_switch_branch(sw, block->succs());
+            for (auto *const visitor : visitors)
+              visitor->on_switch_branch(sw, block->succs());
           }
           break;
         }
@@ -109,7 +137,8 @@ namespace ia::fixpoint
         case Stmt::ContinueStmtClass: {
           if (block->succ_size() == 1)
           {
-            on_simple_jump(terminator, *(block->succ_begin()));
+            for (auto *const visitor : visitors)
+              visitor->on_simple_jump(terminator, *(block->succ_begin()));
           }
           break;
         }
@@ -119,14 +148,59 @@ namespace ia::fixpoint
           {
             const CFGBlock *const b1 = *(block->succ_begin());
             const CFGBlock *const b2 = *(block->succ_begin() + 1);
-            on_conditional_branch(terminator, b2, b1);
+            for (auto *const visitor : visitors)
+              visitor->on_conditional_branch(terminator, b2, b1);
           }
           break;
         }
         }
       }
 
-      on_exit_block(block);
+      for (auto *const visitor : visitors)
+        visitor->on_exit_block(block);
+    }
+  }
+
+  auto ControlFlowBatch::add(ControlFlowVisitor *visitor, const FunctionDecl *func, Ref<MatchResult> result) -> void
+  {
+    if (func != m_func)
+      flush();
+
+    m_func = func;
+    m_pending.push_back({visitor, result});
+  }
+
+  auto ControlFlowBatch::flush() -> void
+  {
+    if (m_pending.empty())
+      return;
+
+    // Visitors asking for different CFG options can't share a walk; group them, keeping the queue order.
+    Mut<Vec<std::pair<CFGOptions, Vec<ControlFlowVisitor *>>>> groups;
+    for (auto &pending : m_pending)
+    {
+      pending.visitor->m_last_match_result = &pending.result;
+
+      const auto options = pending.visitor->get_cfg_options();
+      auto group = std::ranges::find_if(groups, [&](const auto &g) { return g.first == options; });
+      if (group == groups.end())
+      {
+        groups.emplace_back(options, Vec<ControlFlowVisitor *>{});
+        group = std::prev(groups.end());
+      }
+
+      group->second.push_back(pending.visitor);
     }
+
+    auto *const ctx = m_pending.front().result.Context;
+    for (const auto &[options, visitors] : groups)
+    {
+      Mut<std::unique_ptr<clang::CFG>> cfg_storage;
+      if (const auto *const cfg = get_cfg(&m_cfg_cache, m_func, ctx, options, cfg_storage))
+        ControlFlowVisitor::walk(*cfg, visitors);
+    }
+
+    m_pending.clear();
+    m_func = nullptr;
   }
 } // namespace ia::fixpoint
\ No newline at end of file
@@ -15,6 +15,15 @@
 
 #include <fixpoint/fixpoint.hpp>
 
+#include <ast_cache.hpp>
+#include <result_cache.hpp>
+#include <task_prefilter.hpp>
+#include <workload_action.hpp>
+
+#include <llvm/Support/FileSystem.h>
+
+#include <typeinfo>
+
 namespace ia::fixpoint
 {
   Mut<Tool::SyntaxErrorHandlerT> Tool::s_syntax_error_handler = [](Ref<Diagnostic> diagnostics,
@@ -27,7 +36,8 @@ namespace ia::fixpoint
   class StrictDiagnosticConsumer : public clang::DiagnosticConsumer
   {
 public:
-    StrictDiagnosticConsumer(clang::DiagnosticsEngine *engine = nullptr)
+    StrictDiagnosticConsumer(clang::DiagnosticsEngine *engine = nullptr, bool keep_going = false)
+        : m_keep_going(keep_going)
     {
       AU_UNUSED(engine);
 
@@ -51,8 +61,12 @@ public:
 
       m_has_error = true;
 
+      // TUs may be parsed on several worker threads; keep the handler (and whatever it prints) serialized.
+      static Mut<std::mutex> handler_lock;
+      const std::lock_guard<std::mutex> guard(handler_lock);
+
       const auto exit_code = Tool::get_syntax_error_handler()(info, m_printer.get());
-      if (exit_code)
+      if (exit_code && !m_keep_going)
         exit(exit_code);
     }
 
@@ -65,14 +79,12 @@ private:
     clang::DiagnosticOptions m_options{};
     Box<DiagnosticPrinter> m_printer;
     bool m_has_error{false};
+    bool m_keep_going{false};
   };
 
-  static auto get_clang_resource_dir() -> String &
+  static auto query_clang_resource_dir() -> String
   {
-    static thread_local Mut<String> result;
-
-    if (!result.empty())
-      return result;
+    Mut<String> result;
 
 #if defined(_WIN32)
     FILE *const pipe = _popen("clang -print-resource-dir", "r");
@@ -97,20 +109,69 @@ private:
 
     return result;
   }
+
+  // Queried once per process; the static initialization is thread-safe and the result is read-only afterwards,
+  // so argument adjusters running on worker threads can share it.
+  static auto get_clang_resource_dir() -> Ref<String>
+  {
+    static const String result = query_clang_resource_dir();
+    return result;
+  }
+
+  static auto add_task_matcher(MutRef<MatchFinder> finder, IWorkloadTask *task) -> void
+  {
+    finder.addMatcher(clang::ast_matchers::traverse(clang::TK_IgnoreUnlessSpelledInSource,
+                                                    clang::ast_matchers::decl(task->get_matcher()).bind("decl")),
+                      task);
+  }
 } // namespace ia::fixpoint
 
 namespace ia::fixpoint
 {
   auto Tool::create(MutRef<Options> options, Ref<CompileDB> compile_db) -> Result<Box<Tool>>
   {
-    return make_box_protected<Tool>(clang::tooling::ClangTool(compile_db, options.get_cop().getSourcePathList()));
+    const auto &settings = options.get_settings();
+
+    Mut<std::optional<ChangedLines>> changed_lines;
+    if (!settings.diff_file.empty())
+    {
+      auto loaded = ChangedLines::load(settings.diff_file);
+      if (!loaded)
+        return fail("{}", loaded.error());
+
+      changed_lines = std::move(*loaded);
+    }
+
+    if (!settings.result_cache_dir.empty())
+    {
+      if (const auto error = llvm::sys::fs::create_directories(settings.result_cache_dir))
+        return fail("Failed to create the result cache '{}': {}", settings.result_cache_dir, error.message());
+    }
+
+    if (!settings.ast_cache_dir.empty())
+    {
+      if (const auto error = llvm::sys::fs::create_directories(settings.ast_cache_dir))
+        return fail("Failed to create the AST cache '{}': {}", settings.ast_cache_dir, error.message());
+    }
+
+    return make_box_protected<Tool>(compile_db, options.get_cop().getSourcePathList(), settings,
+                                    std::move(changed_lines));
   }
 
-  Tool::Tool(ForwardRef<clang::tooling::ClangTool> ct) : m_clang_tool(std::move(ct))
+  Tool::Tool(Ref<CompileDB> compile_db, Ref<Vec<String>> source_paths, Ref<ToolSettings> settings,
+             std::optional<ChangedLines> changed_lines)
+      : m_compile_db(compile_db), m_source_paths(source_paths), m_settings(settings),
+        m_prefilter(make_box<TaskPrefilter>()), m_changed_lines(std::move(changed_lines))
   {
+    if (!m_settings.result_cache_dir.empty())
+      m_result_cache = make_box<ResultCache>(m_settings.result_cache_dir);
+
+    if (!m_settings.ast_cache_dir.empty())
+      m_ast_cache = make_box<ASTCache>(m_settings.ast_cache_dir);
+
     const auto &resource_dir = get_clang_resource_dir();
 
-    m_clang_tool.appendArgumentsAdjuster([&](const clang::tooling::CommandLineArguments &args, LLVM_StringRef) {
+    m_arguments_adjuster = [&](const clang::tooling::CommandLineArguments &args, LLVM_StringRef) {
       clang::tooling::CommandLineArguments new_args;
 
       if (!args.empty())
@@ -181,24 +242,361 @@ namespace ia::fixpoint
         new_args.push_back(std::string(arg));
       }
       return new_args;
+    };
+  }
+
+  Tool::~Tool() = default;
+
+  auto Tool::run(Ref<Workload> workload) -> Result<RunReport>
+  {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    Mut<Vec<IWorkloadTask *>> tasks;
+    for (auto &task : workload.get_tasks())
+      tasks.push_back(task.get());
+
+    if (auto valid = TaskPrefilter::validate(tasks); !valid)
+      return fail("{}", valid.error());
+
+    m_cache_results = m_result_cache && ResultCache::is_cacheable(tasks);
+
+    const auto execute = [&](Ref<Vec<IWorkloadTask *>> run_tasks) -> Result<ExecutionResult> {
+      return m_settings.processes ? run_files_sharded(workload, run_tasks) : run_files(workload, run_tasks);
+    };
+
+    Mut<Vec<bool>> failed(m_source_paths.size(), false);
+    Mut<CFGCacheStats> cfg_cache;
+    Mut<u32> skipped_parses = 0;
+    Mut<DiskCacheStats> result_cache;
+    Mut<DiskCacheStats> ast_cache;
+
+    const auto record_failures = [&](Result<ExecutionResult> result) -> Result<void> {
+      if (!result)
+        return fail("{}", result.error());
+
+      for (const auto index : result->failed)
+        failed[index] = true;
+
+      cfg_cache += result->cfg_cache;
+      skipped_parses += result->skipped_parses;
+      result_cache += result->result_cache;
+      ast_cache += result->ast_cache;
+      return {};
+    };
+
+    if (m_settings.single_parse)
+    {
+      if (auto result = record_failures(execute(tasks)); !result)
+        return fail("{}", result.error());
+    }
+    else
+    {
+      for (auto *task : tasks)
+      {
+        if (auto result = record_failures(execute({task})); !result)
+          return fail("{}", result.error());
+      }
+    }
+
+    Mut<Vec<String>> failed_files;
+    for (size_t i = 0; i < failed.size(); ++i)
+    {
+      if (failed[i])
+        failed_files.push_back(m_source_paths[i]);
+    }
+
+    if (!failed_files.empty() && !m_settings.keep_going)
+    {
+      Mut<String> files;
+      for (const auto &file : failed_files)
+        files += std::format("\n  {}", file);
+
+      return fail("{} translation unit(s) failed:{}", failed_files.size(), files);
+    }
+
+    const auto worker_count = m_settings.processes ? m_settings.processes : utils::get_worker_count(m_settings.jobs);
+
+    return RunReport{
+        .jobs = static_cast<u32>(std::min<size_t>(worker_count, m_source_paths.size())),
+        .translation_units = static_cast<u32>(m_source_paths.size()),
+        .wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                           start_time),
+        .failed_files = std::move(failed_files),
+        .cfg_cache = cfg_cache,
+        .skipped_parses = skipped_parses,
+        .result_cache = result_cache,
+        .ast_cache = ast_cache,
+    };
+  }
+
+  auto Tool::run_files(Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks) -> Result<ExecutionResult>
+  {
+    const auto file_count = m_source_paths.size();
+    const auto worker_count = std::min<size_t>(utils::get_worker_count(m_settings.jobs), file_count);
+
+    // Prototypes are cloned before any TU runs, so per-TU clones never observe results that were already merged
+    // back into the original tasks. Tasks that can't be cloned are shared by every worker and their callbacks
+    // must not run concurrently; parsing (the bulk of the work) still proceeds in parallel. The result cache
+    // needs the results of every TU on their own, so it clones even for a single worker.
+    Mut<Vec<Box<IWorkloadTask>>> prototypes(tasks.size());
+    Mut<bool> needs_match_lock = false;
+
+    if (worker_count > 1 || m_cache_results)
+    {
+      for (size_t i = 0; i < tasks.size(); ++i)
+      {
+        prototypes[i] = tasks[i]->clone();
+        if (!prototypes[i])
+          needs_match_lock = true;
+      }
+    }
+
+    Mut<std::mutex> match_lock;
+    std::mutex *const shared_match_lock = needs_match_lock ? &match_lock : nullptr;
+
+    Mut<Vec<i32>> results(file_count, 0);
+    Mut<Vec<TranslationUnitStats>> tu_stats(file_count);
+
+    Mut<std::mutex> merge_lock;
+    Mut<size_t> next_to_merge = 0;
+    Mut<Vec<bool>> finished(file_count, false);
+    Mut<Vec<Vec<Box<IWorkloadTask>>>> pending_clones(file_count);
+
+    utils::parallel_for(m_settings.jobs, file_count, [&](size_t index, u32 worker) {
+      AU_UNUSED(worker);
+
+      Mut<Vec<Box<IWorkloadTask>>> clones(tasks.size());
+      Mut<Vec<IWorkloadTask *>> tu_tasks = tasks;
+
+      for (size_t i = 0; i < tasks.size(); ++i)
+      {
+        if (!prototypes[i])
+          continue;
+
+        clones[i] = prototypes[i]->clone();
+        tu_tasks[i] = clones[i].get();
+      }
+
+      results[index] =
+          run_translation_unit(m_source_paths[index], workload, tu_tasks, shared_match_lock, tu_stats[index]);
+
+      // Reduce in source list order, independent of which worker finished first.
+      const std::lock_guard<std::mutex> guard(merge_lock);
+
+      pending_clones[index] = std::move(clones);
+      finished[index] = true;
+
+      for (; next_to_merge < file_count && finished[next_to_merge]; ++next_to_merge)
+      {
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+          if (const auto &clone = pending_clones[next_to_merge][i])
+            tasks[i]->merge_from(*clone);
+        }
+
+        pending_clones[next_to_merge].clear();
+      }
     });
 
-    m_clang_tool.setDiagnosticConsumer(new StrictDiagnosticConsumer());
+    Mut<ExecutionResult> execution;
+    for (size_t index = 0; index < file_count; ++index)
+    {
+      if (results[index] != 0)
+        execution.failed.push_back(index);
+
+      execution.cfg_cache += tu_stats[index].cfg_cache;
+      execution.skipped_parses += tu_stats[index].skipped ? 1 : 0;
+      execution.result_cache += tu_stats[index].result_cache;
+      execution.ast_cache += tu_stats[index].ast_cache;
+    }
+
+    return execution;
   }
 
-  auto Tool::run(Ref<Workload> workload) -> Result<void>
+  auto Tool::run_translation_unit(Ref<String> file, Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks,
+                                  std::mutex *match_lock, MutRef<TranslationUnitStats> stats) -> i32
   {
-    for (auto &task : workload.get_tasks())
+    const auto commands = m_compile_db.getCompileCommands(file);
+    const auto *const command = commands.empty() ? nullptr : &commands.front();
+
+    // A valid cache entry replays the results of every task, without prefiltering or parsing the TU.
+    Mut<String> cache_key;
+    if (m_cache_results)
+    {
+      cache_key = ResultCache::make_key(get_result_cache_inputs(file, workload, tasks, commands));
+      if (const auto entry = m_result_cache->lookup(cache_key); entry && entry->results.size() == tasks.size())
+      {
+        for (size_t i = 0; i < tasks.size(); ++i)
+          tasks[i]->import_results(entry->results[i]);
+
+        stats.result_cache.hits++;
+        return 0;
+      }
+    }
+
+    const auto active_tasks = m_prefilter->select_tasks(file, command, tasks);
+    if (active_tasks.empty() ||
+        (m_changed_lines && !m_prefilter->includes_changed_file(file, command, *m_changed_lines)))
+    {
+      stats.skipped = true;
+      return 0;
+    }
+
+    // Every task gets its own "decl" binding on the shared finder, so the TU is parsed once and the
+    // matched nodes are dispatched to the tasks (in registration order) from a single traversal.
+    MatchFinder finder;
+    for (auto *task : active_tasks)
+      add_task_matcher(finder, task);
+
+    // Every TU gets its own ClangTool over a private physical file system: ClangTool changes the working
+    // directory of its file system per compile command, which must not leak into concurrently running TUs.
+    clang::tooling::ClangTool clang_tool(m_compile_db, {file}, std::make_shared<clang::PCHContainerOperations>(),
+                                         llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>(
+                                             llvm::vfs::createPhysicalFileSystem()));
+    clang_tool.appendArgumentsAdjuster(m_arguments_adjuster);
+
+    StrictDiagnosticConsumer diagnostic_consumer(nullptr, m_settings.keep_going);
+    clang_tool.setDiagnosticConsumer(&diagnostic_consumer);
+
+    Mut<Vec<String>> dependencies;
+
+    const bool needs_header_bodies =
+        std::ranges::any_of(active_tasks, [](const auto *task) { return task->needs_header_function_bodies(); });
+
+    const WorkloadActionConfig config{
+        .finder = &finder,
+        .tasks = active_tasks,
+        .match_lock = match_lock,
+        .skip_on_error = m_settings.keep_going,
+        .main_file_only = workload.is_main_file_only(),
+        .fuse_control_flow_visitors = workload.is_fusing_control_flow_visitors(),
+        .skip_header_bodies = m_settings.skip_header_bodies && !needs_header_bodies,
+        .header_body_allowlist = m_settings.header_body_allowlist,
+        .changed_lines = m_changed_lines ? &*m_changed_lines : nullptr,
+        .cfg_stats = &stats.cfg_cache,
+        .dependencies = cache_key.empty() ? nullptr : &dependencies,
+    };
+
+    Mut<i32> status = 0;
+    if (m_ast_cache && commands.size() == 1)
+      status = run_with_ast_cache(clang_tool, config, file, commands.front(), stats);
+    else
+    {
+      WorkloadActionFactory factory(config);
+      status = clang_tool.run(&factory);
+    }
+
+    // The consumer doesn't forward to clang::DiagnosticConsumer::HandleDiagnostic(), so ExecuteAction() never
+    // sees the errors and the run succeeds; report them here.
+    if (status == 0 && diagnostic_consumer.has_error())
+      status = 1;
+
+    if (!cache_key.empty())
+    {
+      stats.result_cache.misses++;
+
+      if (status == 0)
+      {
+        // The diff decides which declarations are analyzed, so it is validated like any other input file.
+        if (m_changed_lines)
+        {
+          Mut<llvm::SmallString<256>> diff_path(m_settings.diff_file);
+          llvm::sys::fs::make_absolute(diff_path);
+          dependencies.push_back(String(diff_path.str()));
+        }
+
+        Mut<Vec<String>> results;
+        for (const auto *task : tasks)
+          results.push_back(task->export_results());
+
+        m_result_cache->store(cache_key, dependencies, results);
+      }
+    }
+
+    return status;
+  }
+
+  auto Tool::run_with_ast_cache(MutRef<clang::tooling::ClangTool> clang_tool, Ref<WorkloadActionConfig> config,
+                                Ref<String> file, Ref<CompileCommand> command, MutRef<TranslationUnitStats> stats)
+      -> i32
+  {
+    const auto key = ResultCache::make_key(get_command_inputs(file, {command}));
+
+    Mut<Vec<String>> dependencies;
+    if (auto unit = m_ast_cache->load(key, command.Directory, dependencies))
+    {
+      stats.ast_cache.hits++;
+
+      if (config.dependencies)
+        *config.dependencies = std::move(dependencies);
+
+      WorkloadConsumer consumer(config, nullptr);
+      consumer.HandleTranslationUnit(unit->getASTContext());
+      return 0;
+    }
+
+    stats.ast_cache.misses++;
+
+    // Lets the reader accept inputs that were only touched since the AST was saved (see ASTCache::load()).
+    clang_tool.appendArgumentsAdjuster(clang::tooling::getInsertArgumentAdjuster(
+        "-fvalidate-ast-input-files-content", clang::tooling::ArgumentInsertPosition::BEGIN));
+
+    Mut<Vec<std::unique_ptr<clang::ASTUnit>>> units;
+    Mut<i32> status = clang_tool.buildASTs(units);
+    if (units.size() != 1 || !units.front())
+      return status ? status : 1;
+
+    // buildASTs() succeeds whenever it gets a unit, even one with compile errors; report those like run() does.
+    auto &unit = *units.front();
+    if (unit.getDiagnostics().hasErrorOccurred())
+      status = 1;
+
+    dependencies = ASTCache::get_dependencies(unit);
+    if (config.dependencies)
+      *config.dependencies = dependencies;
+
+    WorkloadConsumer consumer(config, nullptr);
+    consumer.HandleTranslationUnit(unit.getASTContext());
+
+    if (status == 0)
+      m_ast_cache->store(key, dependencies, unit);
+
+    return status;
+  }
+
+  auto Tool::get_command_inputs(Ref<String> file, Ref<Vec<CompileCommand>> commands) -> Vec<String>
+  {
+    Mut<Vec<String>> inputs{file, std::to_string(commands.size())};
+
+    for (const auto &command : commands)
+    {
+      const auto args = m_arguments_adjuster(command.CommandLine, file);
+
+      inputs.push_back(command.Directory);
+      inputs.push_back(std::to_string(args.size()));
+      inputs.insert(inputs.end(), args.begin(), args.end());
+    }
+
+    return inputs;
+  }
+
+  auto Tool::get_result_cache_inputs(Ref<String> file, Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks,
+                                     Ref<Vec<CompileCommand>> commands) -> Vec<String>
+  {
+    Mut<Vec<String>> inputs = get_command_inputs(file, commands);
+
+    // Parses through the AST cache always keep the header bodies.
+    inputs.push_back(std::format("main_file_only={} skip_header_bodies={} diff={}", workload.is_main_file_only(),
+                                 m_settings.skip_header_bodies && !m_ast_cache, !m_settings.diff_file.empty()));
+    inputs.push_back(std::to_string(m_settings.header_body_allowlist.size()));
+    inputs.insert(inputs.end(), m_settings.header_body_allowlist.begin(), m_settings.header_body_allowlist.end());
+
+    for (const auto *task : tasks)
     {
-      MatchFinder finder;
-      finder.addMatcher(clang::ast_matchers::traverse(clang::TK_IgnoreUnlessSpelledInSource,
-                                                      clang::ast_matchers::decl(task->get_matcher()).bind("decl")),
-                        task.get());
-      const auto result = m_clang_tool.run(clang::tooling::newFrontendActionFactory(&finder).get());
-      if (result != 0)
-        return fail("ClangTool run failed with error code: {}", result);
+      inputs.push_back(typeid(*task).name());
+      inputs.push_back(task->get_cache_version());
     }
 
-    return {};
+    return inputs;
   }
 } // namespace ia::fixpoint
\ No newline at end of file
@@ -0,0 +1,172 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fixpoint/gen_kill_solver.hpp>
+
+namespace ia::fixpoint
+{
+  auto GenKillSolver::run(Ref<MatchResult> result) -> void
+  {
+    const auto *decl = result.Nodes.getNodeAs<Decl>("decl");
+    if (!decl)
+      return;
+
+    m_last_match_result = &result;
+
+    auto *ctx = result.Context;
+
+    if (const auto func = llvm_cast<const FunctionDecl>(decl))
+      analyze_function(func, ctx);
+    else if (const auto record = llvm_cast<const CXXRecordDecl>(decl))
+    {
+      for (const auto method : record->methods())
+        analyze_function(method, ctx);
+    }
+    else if (const auto tu = llvm_cast<const clang::TranslationUnitDecl>(decl))
+    {
+      for (const auto *sub_decl : tu->decls())
+      {
+        if (const auto f = llvm_cast<const FunctionDecl>(sub_decl))
+          analyze_function(f, ctx);
+      }
+    }
+  }
+
+  auto GenKillSolver::gen_kill_element(Ref<clang::CFGElement> element, MutRef<FactSet> gen, MutRef<FactSet> kill)
+      -> const Stmt *
+  {
+    gen.clear();
+    kill.clear();
+
+    if (const auto cfg_stmt = element.getAs<clang::CFGStmt>())
+    {
+      gen_kill(cfg_stmt->getStmt(), gen, kill);
+      return cfg_stmt->getStmt();
+    }
+
+    if (const auto cfg_init = element.getAs<CFGInitializer>())
+      gen_kill_initializer(cfg_init->getInitializer(), gen, kill);
+    else if (const auto cfg_dtor = element.getAs<CFGImplicitDtor>())
+      gen_kill_implicit_dtor(&*cfg_dtor, gen, kill);
+
+    return nullptr;
+  }
+
+  auto GenKillSolver::analyze_function(const FunctionDecl *func, clang::ASTContext *ctx) -> void
+  {
+    if (!func || !func->hasBody())
+      return;
+
+    const SourceLocation loc = func->getLocation();
+    if (ctx->getSourceManager().isInSystemHeader(loc))
+      return;
+
+    auto *const analysis_context = get_analysis_context();
+    if (analysis_context && !analysis_context->is_changed(func))
+      return;
+
+    CFGCache *const cfg_cache = analysis_context ? &analysis_context->get_cfg_cache() : nullptr;
+
+    Mut<std::unique_ptr<clang::CFG>> cfg_storage;
+    const auto *const cfg = get_cfg(cfg_cache, func, ctx, get_cfg_options(), cfg_storage);
+    if (!cfg)
+      return;
+
+    const auto fact_count = get_fact_count(func);
+    const auto block_count = cfg->getNumBlockIDs();
+    const bool intersect = get_join() == GenKillJoin::Intersection;
+
+    const CFGOrder order(*cfg);
+
+    Mut<FactSet> stmt_gen(fact_count);
+    Mut<FactSet> stmt_kill(fact_count);
+
+    // Fold the statements of each block into one gen/kill pair: a later kill removes earlier gens, a later gen
+    // overrides earlier kills.
+    Mut<Vec<FactSet>> block_gen(block_count, FactSet(fact_count));
+    Mut<Vec<FactSet>> block_kill(block_count, FactSet(fact_count));
+
+    for (const auto *block : order.get_blocks())
+    {
+      auto &gen = block_gen[block->getBlockID()];
+      auto &kill = block_kill[block->getBlockID()];
+
+      for (const auto &element : *block)
+      {
+        gen_kill_element(element, stmt_gen, stmt_kill);
+
+        gen.subtract(stmt_kill);
+        gen.union_with(stmt_gen);
+        kill.union_with(stmt_kill);
+        kill.subtract(stmt_gen);
+      }
+    }
+
+    // Must analyses start from "everything holds" so the intersection can only remove facts.
+    Mut<Vec<FactSet>> block_in_states(block_count, FactSet(fact_count, intersect));
+
+    const auto entry_id = cfg->getEntry().getBlockID();
+    block_in_states[entry_id] = FactSet(fact_count);
+    get_entry_state(func, block_in_states[entry_id]);
+
+    CFGWorklist worklist(order);
+    for (const auto *block : order.get_blocks())
+      worklist.push(block);
+
+    m_stats.functions++;
+    m_stats.blocks += order.get_blocks().size();
+
+    Mut<FactSet> out_state(fact_count);
+
+    while (const CFGBlock *block = worklist.pop())
+    {
+      const auto block_id = block->getBlockID();
+      m_stats.block_visits++;
+
+      out_state = block_in_states[block_id];
+      out_state.subtract(block_kill[block_id]);
+      out_state.union_with(block_gen[block_id]);
+
+      for (const CFGBlock *succ : block->succs())
+      {
+        if (!succ)
+          continue;
+
+        auto &succ_in_state = block_in_states[succ->getBlockID()];
+        if (intersect ? succ_in_state.intersect_with(out_state) : succ_in_state.union_with(out_state))
+          worklist.push(succ);
+      }
+    }
+
+    // Replay the blocks once to hand the per statement states to the task. The gen/kill sets are queried again
+    // rather than kept per statement, which would take two fact sets for every element of the function.
+    Mut<FactSet> state(fact_count);
+
+    for (const auto *block : order.get_blocks())
+    {
+      state = block_in_states[block->getBlockID()];
+
+      for (const auto &element : *block)
+      {
+        const auto *stmt = gen_kill_element(element, stmt_gen, stmt_kill);
+        if (stmt)
+          on_statement(stmt, state);
+
+        state.subtract(stmt_kill);
+        state.union_with(stmt_gen);
+      }
+    }
+  }
+} // namespace ia::fixpoint
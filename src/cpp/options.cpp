@@ -15,16 +15,97 @@
 
 #include <fixpoint/options.hpp>
 
+#include <llvm/ADT/StringMap.h>
+
 namespace ia::fixpoint
 {
+  static Mut<llvm::cl::opt<bool>> s_single_parse(
+      "single-parse", llvm::cl::desc("Parse each translation unit once and run all tasks off the same AST"),
+      llvm::cl::init(true));
+
+  static Mut<llvm::cl::opt<u32>> s_jobs(
+      "jobs", llvm::cl::desc("Number of translation units to analyze in parallel (0 = one per hardware thread)"),
+      llvm::cl::init(1));
+
+  static Mut<llvm::cl::opt<u32>> s_processes(
+      "processes", llvm::cl::desc("Shard the translation units over this many forked worker processes (0 = off)"),
+      llvm::cl::init(0));
+
+  static Mut<llvm::cl::opt<u32>> s_crash_retries(
+      "crash-retries", llvm::cl::desc("Retries for a translation unit whose worker process crashed"),
+      llvm::cl::init(1));
+
+  static Mut<llvm::cl::opt<bool>> s_keep_going(
+      "keep-going", llvm::cl::desc("Skip translation units that fail to compile and report them at the end"),
+      llvm::cl::init(false));
+
+  static Mut<llvm::cl::opt<bool>> s_skip_header_bodies(
+      "skip-header-bodies", llvm::cl::desc("Don't parse the bodies of functions declared outside the main file"),
+      llvm::cl::init(false));
+
+  static Mut<llvm::cl::list<std::string>> s_keep_bodies_in(
+      "keep-bodies-in", llvm::cl::desc("Path prefix whose function bodies are parsed despite --skip-header-bodies"),
+      llvm::cl::value_desc("path"));
+
+  static Mut<llvm::cl::opt<std::string>> s_diff(
+      "diff", llvm::cl::desc("Only analyze the declarations overlapping the lines changed by this unified diff"),
+      llvm::cl::value_desc("path"));
+
+  static Mut<llvm::cl::opt<std::string>> s_result_cache(
+      "result-cache", llvm::cl::desc("Store task results here and replay them for unchanged translation units"),
+      llvm::cl::value_desc("dir"));
+
+  static Mut<llvm::cl::opt<std::string>> s_ast_cache(
+      "ast-cache", llvm::cl::desc("Save parsed translation units here and load them instead of reparsing"),
+      llvm::cl::value_desc("dir"));
+
+  static auto register_tool_options(MutRef<llvm::cl::OptionCategory> category) -> void
+  {
+    s_single_parse.addCategory(category);
+    s_jobs.addCategory(category);
+    s_processes.addCategory(category);
+    s_crash_retries.addCategory(category);
+    s_keep_going.addCategory(category);
+    s_skip_header_bodies.addCategory(category);
+    s_keep_bodies_in.addCategory(category);
+    s_diff.addCategory(category);
+    s_result_cache.addCategory(category);
+    s_ast_cache.addCategory(category);
+  }
+
   auto Options::create(Ref<String> name, i32 argc, const char **argv) -> Result<Options>
   {
-    Mut<llvm::cl::OptionCategory> category(std::format("{} options", name));
+    // Categories (and their names) have to outlive every call since registered options keep pointing at them. One
+    // is kept per tool name, so every tool creating its options in this process gets a "<name> options" section.
+    static Mut<llvm::StringMap<Box<llvm::cl::OptionCategory>>> categories;
+
+    auto [entry, inserted] = categories.try_emplace(std::format("{} options", name));
+    if (inserted)
+    {
+      entry->second = make_box<llvm::cl::OptionCategory>(entry->getKey());
+      register_tool_options(*entry->second);
+    }
+    auto &category = *entry->second;
+
     auto expected_parser = mut(clang::tooling::CommonOptionsParser::create(argc, argv, category));
     if (!expected_parser)
       return fail("Failed to create options from arguments: {}", llvm::toString(expected_parser.takeError()));
 
-    return Options{std::move(expected_parser.get()), name};
+    Mut<Options> options{std::move(expected_parser.get()), name};
+
+    auto &settings = options.get_settings();
+    settings.single_parse = s_single_parse;
+    settings.jobs = s_jobs;
+    settings.processes = s_processes;
+    settings.crash_retries = s_crash_retries;
+    settings.keep_going = s_keep_going;
+    settings.skip_header_bodies = s_skip_header_bodies;
+    settings.header_body_allowlist.assign(s_keep_bodies_in.begin(), s_keep_bodies_in.end());
+    settings.diff_file = s_diff;
+    settings.result_cache_dir = s_result_cache;
+    settings.ast_cache_dir = s_ast_cache;
+
+    return options;
   }
 
   Options::Options(ForwardRef<clang::tooling::CommonOptionsParser> cop, Ref<String> name)
@@ -0,0 +1,437 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fixpoint/fixpoint.hpp>
+
+#include <cstring>
+#include <optional>
+
+#if !defined(_WIN32)
+#  include <poll.h>
+#  include <signal.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+namespace ia::fixpoint
+{
+  auto Tool::run_files_sharded(Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks) -> Result<ExecutionResult>
+  {
+    AU_UNUSED(workload);
+    AU_UNUSED(tasks);
+    return fail("Process sharding is not supported on Windows");
+  }
+
+  auto Tool::run_shard_worker(Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks, Ref<Vec<size_t>> queue,
+                              i32 fd) -> void
+  {
+    AU_UNUSED(workload);
+    AU_UNUSED(tasks);
+    AU_UNUSED(queue);
+    AU_UNUSED(fd);
+  }
+} // namespace ia::fixpoint
+
+#else
+
+namespace ia::fixpoint
+{
+  // Worker -> parent protocol: every frame is a u64 length followed by a ShardMessage tag and its payload.
+  //   Begin: u64 file index
+  //   Done:  u64 file index, i32 status, u64 CFG builds, u64 CFG cache hits, u8 parse skipped, u8 result cache hit,
+  //          u8 result cache miss, u8 AST cache hit, u8 AST cache miss, then per task a u8 presence flag and (if
+  //          present) a u64 sized blob
+  enum class ShardMessage : u8
+  {
+    Begin = 'B',
+    Done = 'D',
+  };
+
+  struct ShardWorker
+  {
+    pid_t pid{-1};
+    i32 fd{-1};
+    Vec<size_t> queue;
+    size_t done_count{0};
+    bool in_flight{false};
+    String buffer;
+  };
+
+  struct ShardResult
+  {
+    bool completed{false};
+    i32 status{0};
+    CFGCacheStats cfg_cache;
+    u8 skipped{0};
+    u8 result_cache_hit{0};
+    u8 result_cache_miss{0};
+    u8 ast_cache_hit{0};
+    u8 ast_cache_miss{0};
+    Vec<std::optional<String>> blobs;
+  };
+
+  template<typename T> static auto append_pod(MutRef<String> out, T value) -> void
+  {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  template<typename T> static auto read_pod(MutRef<LLVM_StringRef> in, MutRef<T> value) -> bool
+  {
+    if (in.size() < sizeof(T))
+      return false;
+
+    std::memcpy(&value, in.data(), sizeof(T));
+    in = in.drop_front(sizeof(T));
+    return true;
+  }
+
+  static auto write_all(i32 fd, Mut<LLVM_StringRef> data) -> bool
+  {
+    while (!data.empty())
+    {
+      const auto written = ::write(fd, data.data(), data.size());
+      if (written < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+
+      data = data.drop_front(static_cast<size_t>(written));
+    }
+
+    return true;
+  }
+
+  static auto send_shard_message(i32 fd, ShardMessage kind, Ref<String> payload) -> bool
+  {
+    Mut<String> frame;
+    append_pod<u64>(frame, payload.size() + 1);
+    append_pod<u8>(frame, static_cast<u8>(kind));
+    frame += payload;
+
+    return write_all(fd, frame);
+  }
+
+  static auto flush_output_streams() -> void
+  {
+    llvm::outs().flush();
+    llvm::errs().flush();
+    std::fflush(nullptr);
+  }
+
+  static auto parse_shard_frames(MutRef<ShardWorker> worker, MutRef<Vec<ShardResult>> results, size_t task_count)
+      -> void
+  {
+    Mut<LLVM_StringRef> pending = worker.buffer;
+
+    while (true)
+    {
+      Mut<LLVM_StringRef> cursor = pending;
+      Mut<u64> size = 0;
+      if (!read_pod(cursor, size) || cursor.size() < size)
+        break;
+
+      Mut<LLVM_StringRef> frame = cursor.take_front(size);
+      pending = cursor.drop_front(size);
+
+      Mut<u8> kind = 0;
+      Mut<u64> index = 0;
+      if (!read_pod(frame, kind) || !read_pod(frame, index) || index >= results.size())
+        continue;
+
+      if (kind == static_cast<u8>(ShardMessage::Begin))
+      {
+        worker.in_flight = true;
+        continue;
+      }
+
+      auto &result = results[index];
+      result.completed = true;
+      result.blobs.assign(task_count, std::nullopt);
+      read_pod(frame, result.status);
+      read_pod(frame, result.cfg_cache.builds);
+      read_pod(frame, result.cfg_cache.hits);
+      read_pod(frame, result.skipped);
+      read_pod(frame, result.result_cache_hit);
+      read_pod(frame, result.result_cache_miss);
+      read_pod(frame, result.ast_cache_hit);
+      read_pod(frame, result.ast_cache_miss);
+
+      for (size_t i = 0; i < task_count; ++i)
+      {
+        Mut<u8> present = 0;
+        Mut<u64> blob_size = 0;
+        if (!read_pod(frame, present) || !present || !read_pod(frame, blob_size) || frame.size() < blob_size)
+          continue;
+
+        result.blobs[i] = frame.take_front(blob_size).str();
+        frame = frame.drop_front(blob_size);
+      }
+
+      worker.in_flight = false;
+      worker.done_count++;
+    }
+
+    worker.buffer.erase(0, worker.buffer.size() - pending.size());
+  }
+
+  static auto terminate_workers(MutRef<Vec<ShardWorker>> workers) -> void
+  {
+    for (auto &worker : workers)
+    {
+      ::kill(worker.pid, SIGKILL);
+      ::close(worker.fd);
+      while (::waitpid(worker.pid, nullptr, 0) < 0 && errno == EINTR)
+        ;
+    }
+
+    workers.clear();
+  }
+
+  auto Tool::run_shard_worker(Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks, Ref<Vec<size_t>> queue,
+                              i32 fd) -> void
+  {
+    for (const auto index : queue)
+    {
+      Mut<String> begin;
+      append_pod<u64>(begin, index);
+      if (!send_shard_message(fd, ShardMessage::Begin, begin))
+        return;
+
+      // Tasks without clone() run on this process' copy of the original task: their side effects (e.g. printed
+      // findings) survive, their in-memory results don't.
+      Mut<Vec<Box<IWorkloadTask>>> clones(tasks.size());
+      Mut<Vec<IWorkloadTask *>> tu_tasks = tasks;
+
+      for (size_t i = 0; i < tasks.size(); ++i)
+      {
+        clones[i] = tasks[i]->clone();
+        if (clones[i])
+          tu_tasks[i] = clones[i].get();
+      }
+
+      Mut<TranslationUnitStats> stats;
+      const auto status = run_translation_unit(m_source_paths[index], workload, tu_tasks, nullptr, stats);
+
+      Mut<String> done;
+      append_pod<u64>(done, index);
+      append_pod<i32>(done, status);
+      append_pod<u64>(done, stats.cfg_cache.builds);
+      append_pod<u64>(done, stats.cfg_cache.hits);
+      append_pod<u8>(done, stats.skipped ? 1 : 0);
+      append_pod<u8>(done, static_cast<u8>(stats.result_cache.hits));
+      append_pod<u8>(done, static_cast<u8>(stats.result_cache.misses));
+      append_pod<u8>(done, static_cast<u8>(stats.ast_cache.hits));
+      append_pod<u8>(done, static_cast<u8>(stats.ast_cache.misses));
+
+      for (const auto &clone : clones)
+      {
+        append_pod<u8>(done, clone ? 1 : 0);
+        if (!clone)
+          continue;
+
+        const auto blob = clone->export_results();
+        append_pod<u64>(done, blob.size());
+        done += blob;
+      }
+
+      if (!send_shard_message(fd, ShardMessage::Done, done))
+        return;
+    }
+  }
+
+  auto Tool::run_files_sharded(Ref<Workload> workload, Ref<Vec<IWorkloadTask *>> tasks) -> Result<ExecutionResult>
+  {
+    const auto file_count = m_source_paths.size();
+    const auto shard_count = std::min<size_t>(m_settings.processes, file_count);
+
+    Mut<Vec<ShardResult>> results(file_count);
+    Mut<Vec<u32>> attempts(file_count, 0);
+    Mut<Vec<size_t>> crashed;
+    Mut<Vec<ShardWorker>> workers;
+
+    const auto spawn = [&](ForwardRef<Vec<size_t>> queue) -> bool {
+      Mut<i32> fds[2];
+      if (::pipe(fds) != 0)
+        return false;
+
+      // Anything still buffered would otherwise be flushed twice, once by each process.
+      flush_output_streams();
+
+      const pid_t pid = ::fork();
+      if (pid < 0)
+      {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return false;
+      }
+
+      if (pid == 0)
+      {
+        ::close(fds[0]);
+        for (const auto &worker : workers)
+          ::close(worker.fd);
+
+        run_shard_worker(workload, tasks, queue, fds[1]);
+
+        flush_output_streams();
+        ::_exit(0);
+      }
+
+      ::close(fds[1]);
+      workers.push_back(ShardWorker{.pid = pid, .fd = fds[0], .queue = std::move(queue)});
+      return true;
+    };
+
+    for (size_t shard = 0; shard < shard_count; ++shard)
+    {
+      Mut<Vec<size_t>> queue;
+      for (auto index = shard * file_count / shard_count; index < (shard + 1) * file_count / shard_count; ++index)
+        queue.push_back(index);
+
+      if (!spawn(std::move(queue)))
+      {
+        terminate_workers(workers);
+        return fail("Failed to fork a worker process: {}", std::strerror(errno));
+      }
+    }
+
+    Mut<Vec<char>> read_buffer(64 * 1024);
+
+    while (!workers.empty())
+    {
+      Mut<Vec<pollfd>> poll_fds;
+      for (const auto &worker : workers)
+        poll_fds.push_back(pollfd{.fd = worker.fd, .events = POLLIN, .revents = 0});
+
+      if (::poll(poll_fds.data(), poll_fds.size(), -1) < 0)
+      {
+        if (errno == EINTR)
+          continue;
+
+        terminate_workers(workers);
+        return fail("Failed to poll worker processes: {}", std::strerror(errno));
+      }
+
+      Mut<Vec<Vec<size_t>>> respawn_queues;
+
+      for (size_t i = workers.size(); i-- > 0;)
+      {
+        if (!poll_fds[i].revents)
+          continue;
+
+        auto &worker = workers[i];
+
+        const auto bytes_read = ::read(worker.fd, read_buffer.data(), read_buffer.size());
+        if (bytes_read < 0 && errno == EINTR)
+          continue;
+
+        if (bytes_read > 0)
+        {
+          worker.buffer.append(read_buffer.data(), static_cast<size_t>(bytes_read));
+          parse_shard_frames(worker, results, tasks.size());
+          continue;
+        }
+
+        // EOF (or a broken pipe): the worker is done, or it died on the TU it was working on.
+        ::close(worker.fd);
+
+        Mut<i32> status = 0;
+        while (::waitpid(worker.pid, &status, 0) < 0 && errno == EINTR)
+          ;
+
+        const auto position = std::min(worker.done_count, worker.queue.size());
+        const bool exited_cleanly = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+        if (position < worker.queue.size() && !exited_cleanly)
+        {
+          const auto index = worker.queue[position];
+
+          // A non-zero exit in the middle of a TU is the syntax error handler asking to stop the analysis.
+          if (worker.in_flight && WIFEXITED(status))
+          {
+            workers.erase(workers.begin() + static_cast<std::ptrdiff_t>(i));
+            terminate_workers(workers);
+            std::exit(WEXITSTATUS(status));
+          }
+
+          llvm::errs() << "Worker process for '" << m_source_paths[index] << "' "
+                       << (WIFSIGNALED(status) ? std::format("was killed by signal {}", WTERMSIG(status))
+                                               : String("exited unexpectedly"))
+                       << "\n";
+
+          Mut<Vec<size_t>> rest(worker.queue.begin() + static_cast<std::ptrdiff_t>(position) + 1,
+                                worker.queue.end());
+
+          if (++attempts[index] <= m_settings.crash_retries)
+            rest.insert(rest.begin(), index);
+          else
+            crashed.push_back(index);
+
+          if (!rest.empty())
+            respawn_queues.push_back(std::move(rest));
+        }
+        else if (position < worker.queue.size())
+        {
+          respawn_queues.emplace_back(worker.queue.begin() + static_cast<std::ptrdiff_t>(position),
+                                      worker.queue.end());
+        }
+
+        workers.erase(workers.begin() + static_cast<std::ptrdiff_t>(i));
+      }
+
+      for (auto &queue : respawn_queues)
+      {
+        if (!spawn(std::move(queue)))
+        {
+          terminate_workers(workers);
+          return fail("Failed to fork a worker process: {}", std::strerror(errno));
+        }
+      }
+    }
+
+    for (size_t index = 0; index < file_count; ++index)
+    {
+      const auto &result = results[index];
+      for (size_t i = 0; i < result.blobs.size(); ++i)
+      {
+        if (result.blobs[i])
+          tasks[i]->import_results(*result.blobs[i]);
+      }
+    }
+
+    Mut<ExecutionResult> execution{.failed = std::move(crashed)};
+    for (size_t index = 0; index < file_count; ++index)
+    {
+      if (results[index].completed && results[index].status != 0)
+        execution.failed.push_back(index);
+
+      execution.cfg_cache += results[index].cfg_cache;
+      execution.skipped_parses += results[index].skipped ? 1 : 0;
+      execution.result_cache.hits += results[index].result_cache_hit;
+      execution.result_cache.misses += results[index].result_cache_miss;
+      execution.ast_cache.hits += results[index].ast_cache_hit;
+      execution.ast_cache.misses += results[index].ast_cache_miss;
+    }
+
+    std::ranges::sort(execution.failed);
+    return execution;
+  }
+} // namespace ia::fixpoint
+
+#endif
\ No newline at end of file
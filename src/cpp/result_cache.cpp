@@ -0,0 +1,183 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <result_cache.hpp>
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+
+namespace ia::fixpoint
+{
+  // Bumped whenever the entry format or the key inputs change.
+  static constexpr const char *ENTRY_HEADER = "fixpoint-results 1";
+
+  static auto hash_bytes(LLVM_StringRef data) -> String
+  {
+    Mut<llvm::MD5> hash;
+    hash.update(data);
+
+    Mut<llvm::MD5::MD5Result> result;
+    hash.final(result);
+    return String(result.digest().str());
+  }
+
+  // Takes the next line off the front of `in`.
+  static auto read_line(MutRef<LLVM_StringRef> in) -> LLVM_StringRef
+  {
+    const auto [line, rest] = in.split('\n');
+    in = rest;
+    return line;
+  }
+
+  static auto read_count(MutRef<LLVM_StringRef> in, LLVM_StringRef label, MutRef<size_t> count) -> bool
+  {
+    const auto [name, value] = read_line(in).split(' ');
+    return name == label && !value.getAsInteger(10, count);
+  }
+
+  ResultCache::ResultCache(Ref<String> directory) : m_directory(directory)
+  {
+  }
+
+  auto ResultCache::is_cacheable(Ref<Vec<IWorkloadTask *>> tasks) -> bool
+  {
+    return std::ranges::all_of(
+        tasks, [](const IWorkloadTask *task) { return !task->get_cache_version().empty() && task->clone(); });
+  }
+
+  auto ResultCache::make_key(Ref<Vec<String>> inputs) -> String
+  {
+    Mut<llvm::MD5> hash;
+    hash.update(ENTRY_HEADER);
+
+    for (const auto &input : inputs)
+    {
+      // Length-prefixed, so no two input lists hash the same bytes.
+      hash.update(std::format("\n{}\n", input.size()));
+      hash.update(input);
+    }
+
+    Mut<llvm::MD5::MD5Result> result;
+    hash.final(result);
+    return String(result.digest().str());
+  }
+
+  auto ResultCache::lookup(Ref<String> key) -> std::optional<Entry>
+  {
+    auto buffer = llvm::MemoryBuffer::getFile(get_entry_path(key));
+    if (!buffer)
+      return std::nullopt;
+
+    Mut<LLVM_StringRef> in = (*buffer)->getBuffer();
+    if (read_line(in) != ENTRY_HEADER)
+      return std::nullopt;
+
+    Mut<Entry> entry;
+
+    Mut<size_t> dependency_count = 0;
+    if (!read_count(in, "dependencies", dependency_count))
+      return std::nullopt;
+
+    for (size_t i = 0; i < dependency_count; ++i)
+    {
+      const auto [hash, path] = read_line(in).split(' ');
+      if (hash_file(String(path)) != std::optional<String>(String(hash)))
+        return std::nullopt;
+
+      entry.dependencies.push_back(String(path));
+    }
+
+    Mut<size_t> result_count = 0;
+    if (!read_count(in, "results", result_count))
+      return std::nullopt;
+
+    for (size_t i = 0; i < result_count; ++i)
+    {
+      Mut<size_t> size = 0;
+      if (read_line(in).getAsInteger(10, size) || in.size() < size)
+        return std::nullopt;
+
+      entry.results.push_back(in.take_front(size).str());
+      in = in.drop_front(size);
+    }
+
+    return entry;
+  }
+
+  auto ResultCache::store(Ref<String> key, Ref<Vec<String>> dependencies, Ref<Vec<String>> results) -> void
+  {
+    Mut<String> entry = std::format("{}\ndependencies {}\n", ENTRY_HEADER, dependencies.size());
+    for (const auto &dependency : dependencies)
+    {
+      const auto hash = hash_file(dependency);
+      if (!hash)
+        return;
+
+      entry += std::format("{} {}\n", *hash, dependency);
+    }
+
+    entry += std::format("results {}\n", results.size());
+    for (const auto &result : results)
+      entry += std::format("{}\n{}", result.size(), result);
+
+    // Written next to the entry and renamed over it, so concurrent readers never see a partial entry.
+    const auto entry_path = get_entry_path(key);
+    Mut<i32> fd = -1;
+    Mut<llvm::SmallString<256>> temp_path;
+    if (llvm::sys::fs::createUniqueFile(entry_path + ".%%%%%%.tmp", fd, temp_path))
+      return;
+
+    {
+      Mut<llvm::raw_fd_ostream> out(fd, true);
+      out << entry;
+      out.close();
+
+      if (out.has_error())
+      {
+        out.clear_error();
+        llvm::sys::fs::remove(temp_path);
+        return;
+      }
+    }
+
+    if (llvm::sys::fs::rename(temp_path, entry_path))
+      llvm::sys::fs::remove(temp_path);
+  }
+
+  auto ResultCache::get_entry_path(Ref<String> key) const -> String
+  {
+    Mut<llvm::SmallString<256>> path(m_directory);
+    llvm::sys::path::append(path, key + ".results");
+    return String(path.str());
+  }
+
+  auto ResultCache::hash_file(Ref<String> path) -> std::optional<String>
+  {
+    {
+      const std::lock_guard<std::mutex> guard(m_lock);
+      if (const auto it = m_file_hashes.find(path); it != m_file_hashes.end())
+        return it->second;
+    }
+
+    Mut<std::optional<String>> hash;
+    if (auto buffer = llvm::MemoryBuffer::getFile(path, false, false))
+      hash = hash_bytes((*buffer)->getBuffer());
+
+    const std::lock_guard<std::mutex> guard(m_lock);
+    return m_file_hashes.try_emplace(path, std::move(hash)).first->second;
+  }
+} // namespace ia::fixpoint
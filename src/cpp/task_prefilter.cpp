@@ -0,0 +1,289 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <task_prefilter.hpp>
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/GlobPattern.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+
+#include <optional>
+
+namespace ia::fixpoint
+{
+  // `path` made absolute against `base` (itself relative to the working directory, if it isn't absolute).
+  static auto make_absolute(LLVM_StringRef base, LLVM_StringRef path) -> String
+  {
+    Mut<llvm::SmallString<256>> result(path);
+    if (!llvm::sys::path::is_absolute(result))
+    {
+      Mut<llvm::SmallString<256>> dir(base);
+      if (llvm::sys::fs::make_absolute(dir))
+        return String(path);
+
+      llvm::sys::path::append(dir, path);
+      result = dir;
+    }
+
+    llvm::sys::path::remove_dots(result, true);
+    return String(result.str());
+  }
+
+  static auto matches_any_glob(Ref<Vec<String>> globs, Ref<String> file, Ref<String> absolute_file) -> bool
+  {
+    for (const auto &glob : globs)
+    {
+      auto pattern = llvm::GlobPattern::create(glob);
+      if (!pattern)
+      {
+        llvm::consumeError(pattern.takeError());
+        continue;
+      }
+
+      if (pattern->match(file) || pattern->match(absolute_file))
+        return true;
+    }
+
+    return false;
+  }
+
+  // The header search directories of a compile command: -iquote ones only apply to "quoted" includes.
+  struct SearchPaths
+  {
+    Vec<String> quote_dirs;
+    Vec<String> include_dirs;
+  };
+
+  static auto get_search_paths(const CompileCommand *command) -> SearchPaths
+  {
+    Mut<SearchPaths> paths;
+    if (!command)
+      return paths;
+
+    const auto &args = command->CommandLine;
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+      const LLVM_StringRef arg = args[i];
+
+      for (const auto &[flag, dirs] : {std::pair<LLVM_StringRef, Vec<String> *>{"-iquote", &paths.quote_dirs},
+                                       std::pair<LLVM_StringRef, Vec<String> *>{"-I", &paths.include_dirs}})
+      {
+        if (!arg.starts_with(flag))
+          continue;
+
+        LLVM_StringRef dir = arg.drop_front(flag.size());
+        if (dir.empty() && i + 1 < args.size())
+          dir = args[++i];
+
+        if (!dir.empty())
+          dirs->push_back(make_absolute(command->Directory, dir));
+        break;
+      }
+    }
+
+    return paths;
+  }
+
+  static auto resolve_include(LLVM_StringRef name, bool angled, LLVM_StringRef includer_dir,
+                              Ref<SearchPaths> paths) -> std::optional<String>
+  {
+    if (llvm::sys::path::is_absolute(name))
+      return llvm::sys::fs::exists(name) ? std::optional<String>(String(name)) : std::nullopt;
+
+    const auto try_dir = [&](LLVM_StringRef dir) -> std::optional<String> {
+      Mut<llvm::SmallString<256>> candidate(dir);
+      llvm::sys::path::append(candidate, name);
+      if (!llvm::sys::fs::exists(candidate))
+        return std::nullopt;
+
+      llvm::sys::path::remove_dots(candidate, true);
+      return String(candidate.str());
+    };
+
+    if (!angled)
+    {
+      if (auto found = try_dir(includer_dir))
+        return found;
+
+      for (const auto &dir : paths.quote_dirs)
+      {
+        if (auto found = try_dir(dir))
+          return found;
+      }
+    }
+
+    for (const auto &dir : paths.include_dirs)
+    {
+      if (auto found = try_dir(dir))
+        return found;
+    }
+
+    return std::nullopt;
+  }
+
+  auto TaskPrefilter::validate(Ref<Vec<IWorkloadTask *>> tasks) -> Result<void>
+  {
+    for (const auto *task : tasks)
+    {
+      for (const auto &glob : task->get_path_globs())
+      {
+        auto pattern = llvm::GlobPattern::create(glob);
+        if (!pattern)
+          return fail("Invalid path glob '{}': {}", glob, llvm::toString(pattern.takeError()));
+      }
+    }
+
+    return {};
+  }
+
+  auto TaskPrefilter::select_tasks(Ref<String> file, const CompileCommand *command, Ref<Vec<IWorkloadTask *>> tasks)
+      -> Vec<IWorkloadTask *>
+  {
+    const auto absolute_file = make_absolute(command ? LLVM_StringRef(command->Directory) : LLVM_StringRef(), file);
+
+    Mut<Vec<IWorkloadTask *>> selected;
+    Mut<std::optional<Vec<const ScannedFile *>>> files;
+
+    for (auto *task : tasks)
+    {
+      const auto globs = task->get_path_globs();
+      if (!globs.empty() && !matches_any_glob(globs, file, absolute_file))
+        continue;
+
+      const auto tokens = task->get_required_tokens();
+      if (!tokens.empty())
+      {
+        // Only lexed once some task asks for tokens, and then shared by all of them.
+        if (!files)
+          files = collect_files(absolute_file, command);
+
+        const bool mentioned = std::ranges::any_of(*files, [&](const ScannedFile *scanned) {
+          return std::ranges::any_of(tokens, [&](Ref<String> token) { return scanned->identifiers.contains(token); });
+        });
+        if (!mentioned)
+          continue;
+      }
+
+      selected.push_back(task);
+    }
+
+    return selected;
+  }
+
+  auto TaskPrefilter::includes_changed_file(Ref<String> file, const CompileCommand *command,
+                                            Ref<ChangedLines> changed_lines) -> bool
+  {
+    const auto absolute_file = make_absolute(command ? LLVM_StringRef(command->Directory) : LLVM_StringRef(), file);
+    if (changed_lines.contains_file(absolute_file))
+      return true;
+
+    const auto files = collect_files(absolute_file, command);
+    return std::ranges::any_of(files, [&](const ScannedFile *scanned) {
+      return changed_lines.contains_file(scanned->path);
+    });
+  }
+
+  auto TaskPrefilter::collect_files(Ref<String> file, const CompileCommand *command) -> Vec<const ScannedFile *>
+  {
+    const auto paths = get_search_paths(command);
+
+    Mut<Vec<const ScannedFile *>> files;
+    Mut<llvm::StringSet<>> seen;
+    Mut<Vec<String>> stack{file};
+    seen.insert(file);
+
+    while (!stack.empty())
+    {
+      const String path = std::move(stack.back());
+      stack.pop_back();
+
+      const auto *scanned = scan(path);
+      if (!scanned)
+        continue;
+
+      files.push_back(scanned);
+
+      const auto includer_dir = llvm::sys::path::parent_path(path);
+      for (const auto &include : scanned->includes)
+      {
+        auto resolved = resolve_include(include.name, include.angled, includer_dir, paths);
+        if (resolved && seen.insert(*resolved).second)
+          stack.push_back(std::move(*resolved));
+      }
+    }
+
+    return files;
+  }
+
+  auto TaskPrefilter::scan(Ref<String> path) -> const ScannedFile *
+  {
+    {
+      const std::lock_guard<std::mutex> guard(m_lock);
+      if (const auto it = m_files.find(path); it != m_files.end())
+        return it->second.get();
+    }
+
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (!buffer)
+      return nullptr;
+
+    auto scanned = make_box<ScannedFile>();
+    scanned->path = path;
+
+    Mut<clang::LangOptions> lang_options;
+    lang_options.CPlusPlus = true;
+    lang_options.CPlusPlus11 = true;
+    lang_options.CPlusPlus14 = true;
+    lang_options.CPlusPlus17 = true;
+    lang_options.CPlusPlus20 = true;
+
+    // Raw lexing: no preprocessing, so comments are skipped but macros aren't expanded and #if'd out code counts.
+    const auto text = (*buffer)->getBuffer();
+    Mut<Lexer> lexer(SourceLocation(), lang_options, text.begin(), text.begin(), text.end());
+
+    Mut<clang::Token> token;
+    Mut<bool> after_hash = false;
+    do
+    {
+      lexer.LexFromRawLexer(token);
+
+      if (token.is(clang::tok::raw_identifier))
+      {
+        const auto identifier = token.getRawIdentifier();
+        scanned->identifiers.insert(identifier);
+
+        if (after_hash && (identifier == "include" || identifier == "include_next" || identifier == "import"))
+        {
+          // The header name isn't a single raw token; read it straight from the buffer.
+          const auto rest = LLVM_StringRef(lexer.getBufferLocation(), text.end() - lexer.getBufferLocation())
+                                .take_until([](char c) { return c == '\n'; })
+                                .ltrim();
+          const char close = rest.starts_with("<") ? '>' : '"';
+          if (rest.starts_with("<") || rest.starts_with("\""))
+          {
+            const auto name = rest.drop_front().take_until([&](char c) { return c == close; });
+            scanned->includes.push_back({String(name), close == '>'});
+          }
+        }
+      }
+
+      after_hash = token.is(clang::tok::hash) && token.isAtStartOfLine();
+    } while (token.isNot(clang::tok::eof));
+
+    const std::lock_guard<std::mutex> guard(m_lock);
+    return m_files.try_emplace(path, std::move(scanned)).first->second.get();
+  }
+} // namespace ia::fixpoint
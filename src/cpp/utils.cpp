@@ -15,6 +15,12 @@
 
 #include <fixpoint/utils.hpp>
 
+#include <clang/Basic/Stack.h>
+#include <llvm/Support/thread.h>
+
+#include <atomic>
+#include <optional>
+
 namespace ia::fixpoint::utils
 {
   [[nodiscard]] auto get_loc_str_path_and_line(Ref<FullSourceLoc> loc) -> String
@@ -155,4 +161,42 @@ namespace ia::fixpoint::utils
 
     return true;
   }
+
+  [[nodiscard]] auto get_worker_count(u32 jobs) -> u32
+  {
+    if (jobs)
+      return jobs;
+
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  auto parallel_for(u32 jobs, size_t count, Ref<std::function<void(size_t index, u32 worker)>> body) -> void
+  {
+    const auto worker_count = static_cast<u32>(std::min<size_t>(get_worker_count(jobs), count));
+
+    if (worker_count <= 1)
+    {
+      for (size_t i = 0; i < count; ++i)
+        body(i, 0);
+      return;
+    }
+
+    Mut<std::atomic<size_t>> next_index{0};
+
+    // llvm::thread rather than std::thread, so workers can ask for the stack size the Clang frontend wants (the
+    // platform default is too small for deeply nested code on Linux and Windows).
+    Mut<Vec<llvm::thread>> workers;
+    workers.reserve(worker_count);
+
+    for (Mut<u32> worker = 0; worker < worker_count; ++worker)
+    {
+      workers.emplace_back(std::optional<unsigned>(clang::DesiredStackSize), [&, worker] {
+        for (Mut<size_t> i = next_index.fetch_add(1); i < count; i = next_index.fetch_add(1))
+          body(i, worker);
+      });
+    }
+
+    for (auto &thread : workers)
+      thread.join();
+  }
 } // namespace ia::fixpoint::utils
\ No newline at end of file
@@ -0,0 +1,148 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <workload_action.hpp>
+
+#include <clang/Frontend/CompilerInstance.h>
+#include <llvm/Support/Path.h>
+
+namespace ia::fixpoint
+{
+  static auto restrict_traversal_to_main_file(MutRef<clang::ASTContext> ctx) -> void
+  {
+    const auto &sm = ctx.getSourceManager();
+
+    Mut<Vec<Decl *>> scope;
+    for (auto *const decl : ctx.getTranslationUnitDecl()->decls())
+    {
+      if (sm.isInMainFile(decl->getLocation()))
+        scope.push_back(decl);
+    }
+
+    // The TranslationUnitDecl itself is still matched; only its children are limited to this scope.
+    ctx.setTraversalScope(scope);
+  }
+
+  // Lists every file the preprocessor enters, for the result cache to validate its entries against.
+  class DependencyRecorder : public clang::DependencyCollector
+  {
+public:
+    bool needSystemDependencies() override
+    {
+      return true;
+    }
+  };
+
+  WorkloadConsumer::WorkloadConsumer(Ref<WorkloadActionConfig> config,
+                                     Arc<clang::DependencyCollector> dependency_collector)
+      : m_config(config), m_dependency_collector(std::move(dependency_collector))
+  {
+  }
+
+  void WorkloadConsumer::HandleTranslationUnit(clang::ASTContext &ctx)
+  {
+    if (m_config.skip_on_error && ctx.getDiagnostics().hasErrorOccurred())
+      return;
+
+    if (m_config.main_file_only)
+      restrict_traversal_to_main_file(ctx);
+
+    Mut<std::unique_lock<std::mutex>> guard;
+    if (m_config.match_lock)
+      guard = std::unique_lock<std::mutex>(*m_config.match_lock);
+
+    Mut<AnalysisContext> analysis_context;
+    analysis_context.set_fuse_control_flow_visitors(m_config.fuse_control_flow_visitors);
+    analysis_context.set_changed_lines(m_config.changed_lines);
+    for (auto *task : m_config.tasks)
+      task->set_analysis_context(&analysis_context);
+
+    m_config.finder->matchAST(ctx);
+    analysis_context.finish();
+
+    for (auto *task : m_config.tasks)
+      task->set_analysis_context(nullptr);
+
+    if (m_config.cfg_stats)
+      *m_config.cfg_stats += analysis_context.get_cfg_cache().get_stats();
+
+    if (m_config.dependencies && m_dependency_collector)
+    {
+      // Relative paths are relative to the compile command's directory, which the file manager resolves against.
+      auto &file_manager = ctx.getSourceManager().getFileManager();
+      for (const auto &dependency : m_dependency_collector->getDependencies())
+      {
+        Mut<llvm::SmallString<256>> path(dependency);
+        file_manager.makeAbsolutePath(path);
+        llvm::sys::path::remove_dots(path, true);
+        m_config.dependencies->push_back(String(path.str()));
+      }
+    }
+  }
+
+  bool WorkloadConsumer::shouldSkipFunctionBody(clang::Decl *decl)
+  {
+    if (!m_config.skip_header_bodies)
+      return false;
+
+    const auto &sm = decl->getASTContext().getSourceManager();
+    const auto location = sm.getFileLoc(decl->getLocation());
+    if (sm.isInMainFile(location))
+      return false;
+
+    const auto file_name = sm.getFilename(location);
+    for (const auto &prefix : m_config.header_body_allowlist)
+    {
+      if (file_name.starts_with(prefix))
+        return false;
+    }
+
+    return true;
+  }
+
+  WorkloadAction::WorkloadAction(Ref<WorkloadActionConfig> config) : m_config(config)
+  {
+  }
+
+  std::unique_ptr<clang::ASTConsumer> WorkloadAction::CreateASTConsumer(clang::CompilerInstance &ci,
+                                                                        llvm::StringRef in_file)
+  {
+    AU_UNUSED(in_file);
+
+    // The parser only asks the consumer about skipping bodies when this is set. Sema still refuses to skip
+    // bodies it needs (constexpr functions, deduced return types).
+    if (m_config.skip_header_bodies)
+      ci.getFrontendOpts().SkipFunctionBodies = true;
+
+    // The preprocessor exists by now, but hasn't entered the main file yet.
+    Mut<Arc<clang::DependencyCollector>> dependency_collector;
+    if (m_config.dependencies)
+    {
+      dependency_collector = std::make_shared<DependencyRecorder>();
+      dependency_collector->attachToPreprocessor(ci.getPreprocessor());
+    }
+
+    return std::make_unique<WorkloadConsumer>(m_config, std::move(dependency_collector));
+  }
+
+  WorkloadActionFactory::WorkloadActionFactory(Ref<WorkloadActionConfig> config) : m_config(config)
+  {
+  }
+
+  std::unique_ptr<clang::FrontendAction> WorkloadActionFactory::create()
+  {
+    return std::make_unique<WorkloadAction>(m_config);
+  }
+} // namespace ia::fixpoint
\ No newline at end of file
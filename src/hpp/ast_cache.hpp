@@ -0,0 +1,53 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <result_cache.hpp>
+
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Serialization/PCHContainerOperations.h>
+
+namespace ia::fixpoint
+{
+  // Serialized ASTs of parsed translation units (ASTUnit::Save()), keyed on the compile command. Every AST comes
+  // with a manifest (a result cache entry without results) listing the content hash of each file it was parsed
+  // from, so a changed header invalidates it just like a result cache entry.
+  class ASTCache
+  {
+public:
+    explicit ASTCache(Ref<String> directory);
+
+    // Absolute paths of the files `unit` was parsed from, system headers included.
+    static auto get_dependencies(Ref<clang::ASTUnit> unit) -> Vec<String>;
+
+    // The AST stored under `key` if its manifest is still valid, with the manifest's dependencies. Relative paths
+    // in the AST are resolved against `working_dir`.
+    auto load(Ref<String> key, Ref<String> working_dir, MutRef<Vec<String>> dependencies)
+        -> std::unique_ptr<clang::ASTUnit>;
+
+    // Best effort, like ResultCache::store().
+    auto store(Ref<String> key, Ref<Vec<String>> dependencies, MutRef<clang::ASTUnit> unit) -> void;
+
+private:
+    [[nodiscard]] auto get_ast_path(Ref<String> key) const -> String;
+
+    const String m_directory;
+    ResultCache m_manifests;
+
+    // Loaded units keep referring to its reader.
+    const clang::PCHContainerOperations m_pch_operations;
+  };
+} // namespace ia::fixpoint
@@ -0,0 +1,68 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/pch.hpp>
+
+#include <llvm/ADT/StringMap.h>
+
+#include <optional>
+
+namespace ia::fixpoint
+{
+  // On-disk store of per translation unit task results (see IWorkloadTask::get_cache_version()). An entry is keyed
+  // on everything that went into the analysis besides file contents, and lists the content hash of every file the
+  // translation unit read; it is only replayed while all of them still match. Safe to use from several worker
+  // threads and processes sharing the directory.
+  class ResultCache
+  {
+public:
+    struct Entry
+    {
+      // Absolute paths of the files the translation unit read.
+      Vec<String> dependencies;
+
+      // One per task.
+      Vec<String> results;
+    };
+
+public:
+    explicit ResultCache(Ref<String> directory);
+
+    // Whether every task opts into caching, i.e. declares a cache version and can be cloned.
+    static auto is_cacheable(Ref<Vec<IWorkloadTask *>> tasks) -> bool;
+
+    // Hashes the inputs (command lines, settings, task versions, ...) into an entry key.
+    static auto make_key(Ref<Vec<String>> inputs) -> String;
+
+    // The entry stored under `key`, if it exists and none of its dependencies changed.
+    auto lookup(Ref<String> key) -> std::optional<Entry>;
+
+    // Best effort: entries that can't be written (or whose dependencies can't be read) are dropped.
+    auto store(Ref<String> key, Ref<Vec<String>> dependencies, Ref<Vec<String>> results) -> void;
+
+private:
+    [[nodiscard]] auto get_entry_path(Ref<String> key) const -> String;
+
+    // The content hash of `path`, or std::nullopt if it can't be read. Memoized for the lifetime of the cache, so
+    // a header shared by many translation units is only hashed once per run.
+    auto hash_file(Ref<String> path) -> std::optional<String>;
+
+    const String m_directory;
+    std::mutex m_lock;
+    llvm::StringMap<std::optional<String>> m_file_hashes;
+  };
+} // namespace ia::fixpoint
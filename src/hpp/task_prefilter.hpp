@@ -0,0 +1,69 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/changed_lines.hpp>
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringSet.h>
+
+namespace ia::fixpoint
+{
+  // Picks the tasks a translation unit is needed for before it gets parsed, from their path globs and required
+  // tokens (see IWorkloadTask). Lexed files are cached, so a header shared by many translation units is only read
+  // once per run. Safe to use from several worker threads.
+  class TaskPrefilter
+  {
+public:
+    // Fails on path globs llvm::GlobPattern can't compile, so a typo stops the run instead of silently matching
+    // nothing.
+    static auto validate(Ref<Vec<IWorkloadTask *>> tasks) -> Result<void>;
+
+    // The subset of `tasks` (in order) that `file` passes the prefilters of. `command` supplies the -I / -iquote
+    // directories the project headers are looked up in, and may be nullptr.
+    auto select_tasks(Ref<String> file, const CompileCommand *command, Ref<Vec<IWorkloadTask *>> tasks)
+        -> Vec<IWorkloadTask *>;
+
+    // Whether `changed_lines` touches `file` or a header it includes from the search paths of `command`. Changes
+    // to system headers (or headers only reachable through them) don't count.
+    auto includes_changed_file(Ref<String> file, const CompileCommand *command, Ref<ChangedLines> changed_lines)
+        -> bool;
+
+private:
+    struct IncludeDirective
+    {
+      String name;
+      bool angled{false};
+    };
+
+    struct ScannedFile
+    {
+      String path;
+      llvm::StringSet<> identifiers;
+      Vec<IncludeDirective> includes;
+    };
+
+    // The main file and every header reachable from it through the search paths of `command` (not the system
+    // ones). Files that can't be read are left out.
+    auto collect_files(Ref<String> file, const CompileCommand *command) -> Vec<const ScannedFile *>;
+
+    // Returns nullptr if `path` can't be read.
+    auto scan(Ref<String> path) -> const ScannedFile *;
+
+    std::mutex m_lock;
+    llvm::StringMap<Box<ScannedFile>> m_files;
+  };
+} // namespace ia::fixpoint
@@ -0,0 +1,97 @@
+// Fixpoint: Powerful C++ Static Analysis, Simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fixpoint/analysis_context.hpp>
+
+#include <clang/Frontend/Utils.h>
+
+#include <mutex>
+
+namespace ia::fixpoint
+{
+  struct WorkloadActionConfig
+  {
+    MatchFinder *finder{};
+
+    // The tasks behind the finder; they get the translation unit's AnalysisContext while matching.
+    Vec<IWorkloadTask *> tasks;
+
+    // When set, matching is serialized across worker threads since the tasks behind the finder are shared.
+    std::mutex *match_lock{};
+
+    // Don't match a TU that failed to compile.
+    bool skip_on_error{false};
+
+    // Limit the traversal scope to the top-level declarations of the main file.
+    bool main_file_only{false};
+
+    // Walk each function's CFG once for all ControlFlowVisitor tasks matching it.
+    bool fuse_control_flow_visitors{false};
+
+    // Skip the bodies of functions declared outside the main file and outside the allowlisted path prefixes.
+    bool skip_header_bodies{false};
+    Vec<String> header_body_allowlist;
+
+    // When set, tasks only analyze the declarations overlapping these changed lines.
+    const ChangedLines *changed_lines{};
+
+    // Receives the CFG cache statistics of the translation unit.
+    CFGCacheStats *cfg_stats{};
+
+    // When set, receives the absolute paths of every file the translation unit read, system headers included.
+    Vec<String> *dependencies{};
+  };
+
+  // Runs the workload's matchers over a parsed translation unit.
+  class WorkloadConsumer : public clang::ASTConsumer
+  {
+public:
+    WorkloadConsumer(Ref<WorkloadActionConfig> config, Arc<clang::DependencyCollector> dependency_collector);
+
+    void HandleTranslationUnit(clang::ASTContext &ctx) override;
+
+    bool shouldSkipFunctionBody(clang::Decl *decl) override;
+
+private:
+    const WorkloadActionConfig m_config;
+    const Arc<clang::DependencyCollector> m_dependency_collector;
+  };
+
+  class WorkloadAction : public clang::ASTFrontendAction
+  {
+public:
+    WorkloadAction(Ref<WorkloadActionConfig> config);
+
+protected:
+    std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance &ci,
+                                                          llvm::StringRef in_file) override;
+
+private:
+    const WorkloadActionConfig m_config;
+  };
+
+  class WorkloadActionFactory : public clang::tooling::FrontendActionFactory
+  {
+public:
+    WorkloadActionFactory(Ref<WorkloadActionConfig> config);
+
+    std::unique_ptr<clang::FrontendAction> create() override;
+
+private:
+    const WorkloadActionConfig m_config;
+  };
+} // namespace ia::fixpoint
\ No newline at end of file
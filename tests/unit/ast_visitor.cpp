@@ -0,0 +1,141 @@
+// Fixpoint: Powerful static analysis, simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "helpers.hpp"
+
+using namespace ia;
+
+namespace
+{
+  class FunctionNameCollector : public fixpoint::ASTVisitor<FunctionNameCollector>
+  {
+public:
+    std::vector<std::string> names;
+
+    auto VisitFunctionDecl(clang::FunctionDecl *decl) -> bool
+    {
+      if (get_match_result()->SourceManager->isInMainFile(decl->getLocation()))
+        names.push_back(decl->getNameAsString());
+      return true;
+    }
+
+    [[nodiscard]] auto export_results() const -> String override
+    {
+      String blob;
+      for (const auto &name : names)
+        blob += name + "\n";
+      return blob;
+    }
+
+    auto import_results(fixpoint::LLVM_StringRef data) -> void override
+    {
+      llvm::SmallVector<fixpoint::LLVM_StringRef> lines;
+      data.split(lines, '\n', -1, false);
+      for (const auto line : lines)
+        names.push_back(line.str());
+    }
+  };
+
+  class CallCounter : public fixpoint::ASTVisitor<CallCounter>
+  {
+public:
+    i32 calls = 0;
+
+    auto VisitCallExpr(clang::CallExpr *) -> bool
+    {
+      calls++;
+      return true;
+    }
+  };
+
+  // Stops its traversal at the first variable.
+  class FirstVarFinder : public fixpoint::ASTVisitor<FirstVarFinder>
+  {
+public:
+    std::vector<std::string> names;
+
+    auto VisitVarDecl(clang::VarDecl *decl) -> bool
+    {
+      names.push_back(decl->getNameAsString());
+      return false;
+    }
+  };
+
+  using FusedVisitors = fixpoint::FusedASTVisitor<FunctionNameCollector, CallCounter, FirstVarFinder>;
+
+  const std::string CODE = R"(
+        int square(int x) { return x * x; }
+        int sum_of_squares(int a, int b) { return square(a) + square(b); }
+        void print() { int unused = sum_of_squares(1, 2); }
+    )";
+} // namespace
+
+IAT_BEGIN_BLOCK(Core, ASTVisitor)
+
+auto test_fused_matches_separate_visitors() -> bool
+{
+  fixpoint::Workload separate;
+  separate.add_task<FunctionNameCollector>();
+  separate.add_task<CallCounter>();
+  separate.add_task<FirstVarFinder>();
+  IAT_CHECK(fixpoint::run_workload_on_code(CODE, separate, [](fixpoint::ToolSettings &) {}));
+
+  fixpoint::Workload fused;
+  fused.add_task<FusedVisitors>();
+  IAT_CHECK(fixpoint::run_workload_on_code(CODE, fused, [](fixpoint::ToolSettings &) {}));
+
+  const auto &tasks = separate.get_tasks();
+  const auto &visitors = static_cast<const FusedVisitors &>(*fused.get_tasks().front());
+
+  const auto &names = static_cast<const FunctionNameCollector &>(*tasks[0]).names;
+  IAT_CHECK((names == std::vector<std::string>{"square", "sum_of_squares", "print"}));
+  IAT_CHECK(visitors.get_visitor<FunctionNameCollector>().names == names);
+
+  IAT_CHECK_EQ(static_cast<const CallCounter &>(*tasks[1]).calls, 3);
+  IAT_CHECK_EQ(visitors.get_visitor<CallCounter>().calls, 3);
+
+  // The visitor that gave up after the first variable doesn't end the walk for the others.
+  IAT_CHECK((static_cast<const FirstVarFinder &>(*tasks[2]).names == std::vector<std::string>{"x"}));
+  IAT_CHECK((visitors.get_visitor<FirstVarFinder>().names == std::vector<std::string>{"x"}));
+
+  return true;
+}
+
+auto test_fused_results_round_trip() -> bool
+{
+  fixpoint::Workload workload;
+  workload.add_task<FusedVisitors>();
+  IAT_CHECK(fixpoint::run_workload_on_code(CODE, workload, [](fixpoint::ToolSettings &) {}));
+
+  const auto &visitors = static_cast<const FusedVisitors &>(*workload.get_tasks().front());
+
+  FusedVisitors imported;
+  imported.import_results(visitors.export_results());
+  imported.import_results(visitors.export_results());
+
+  IAT_CHECK_EQ(imported.get_visitor<FunctionNameCollector>().names.size(), 6u);
+  IAT_CHECK_EQ(imported.get_visitor<FunctionNameCollector>().names.back(), std::string("print"));
+
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_fused_matches_separate_visitors);
+IAT_ADD_TEST(test_fused_results_round_trip);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, ASTVisitor)
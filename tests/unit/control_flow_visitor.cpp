@@ -88,8 +88,65 @@ auto test_if_branch() -> bool
   return true;
 }
 
+auto test_fused_visitors() -> bool
+{
+  const std::string code = R"(
+        int first(int x) {
+            if (x > 0) { return 1; }
+            return 0;
+        }
+        int second(int x) {
+            while (x > 0) { if (x == 3) break; x--; }
+            return x;
+        }
+    )";
+
+  struct Outcome
+  {
+    Arc<CFGStats> a = std::make_shared<CFGStats>();
+    Arc<CFGStats> b = std::make_shared<CFGStats>();
+    fixpoint::CFGCacheStats cfg_cache;
+  };
+
+  const auto run = [&](bool fused) -> std::optional<Outcome> {
+    Outcome outcome;
+
+    fixpoint::Workload workload;
+    workload.set_fuse_control_flow_visitors(fused);
+    workload.add_task(std::make_unique<TestCFGVisitor>(outcome.a));
+    workload.add_task(std::make_unique<TestCFGVisitor>(outcome.b));
+
+    const auto report = fixpoint::run_workload_on_sources({code}, workload, [](fixpoint::ToolSettings &) {});
+    if (!report)
+      return std::nullopt;
+
+    outcome.cfg_cache = report->cfg_cache;
+    return outcome;
+  };
+
+  const auto separate = run(false);
+  const auto fused = run(true);
+  IAT_CHECK(separate.has_value());
+  IAT_CHECK(fused.has_value());
+
+  // Both visitors see the same events either way, but the fused walk never goes back to the CFG cache.
+  IAT_CHECK(separate->a->blocks_entered > 0);
+  IAT_CHECK_EQ(fused->a->blocks_entered, separate->a->blocks_entered);
+  IAT_CHECK_EQ(fused->b->blocks_entered, separate->b->blocks_entered);
+  IAT_CHECK_EQ(fused->a->conditions, separate->a->conditions);
+  IAT_CHECK_EQ(fused->b->jumps, separate->b->jumps);
+
+  IAT_CHECK_EQ(separate->cfg_cache.builds, 2u);
+  IAT_CHECK_EQ(separate->cfg_cache.hits, 2u);
+  IAT_CHECK_EQ(fused->cfg_cache.builds, 2u);
+  IAT_CHECK_EQ(fused->cfg_cache.hits, 0u);
+
+  return true;
+}
+
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_if_branch);
+IAT_ADD_TEST(test_fused_visitors);
 IAT_END_TEST_LIST()
 
 IAT_END_BLOCK()
@@ -15,6 +15,8 @@
 
 #include "helpers.hpp"
 
+#include <set>
+
 using namespace ia;
 
 namespace
@@ -63,6 +65,354 @@ public:
       *m_max_value_reached = std::max(*m_max_value_reached, state.count);
     }
   };
+
+  class InPlaceSaturatingSolver : public SaturatingSolver
+  {
+public:
+    Arc<i32> m_joins;
+
+    InPlaceSaturatingSolver(Arc<i32> max_value, Arc<i32> joins) : SaturatingSolver(max_value), m_joins(joins)
+    {
+    }
+
+    auto join_into(MutRef<State> target, Ref<State> incoming) -> bool override
+    {
+      (*m_joins)++;
+
+      if (incoming.count <= target.count)
+        return false;
+
+      target.count = incoming.count;
+      return true;
+    }
+  };
+
+  class LeanSaturatingSolver : public SaturatingSolver
+  {
+public:
+    using SaturatingSolver::SaturatingSolver;
+
+    [[nodiscard]] auto get_state_storage() const -> fixpoint::StateStorage override
+    {
+      return fixpoint::StateStorage::JoinPoints;
+    }
+  };
+
+  // Records the state every statement sees on its (only) visit and checks it against the post-solve queries.
+  class StateQuerySolver : public fixpoint::DataFlowSolver<State>
+  {
+    fixpoint::StateStorage m_storage;
+    std::vector<std::pair<const fixpoint::Stmt *, i32>> m_seen;
+
+public:
+    Arc<i32> m_mismatches;
+    Arc<i32> m_queries;
+
+    StateQuerySolver(fixpoint::StateStorage storage, Arc<i32> mismatches, Arc<i32> queries)
+        : m_storage(storage), m_mismatches(mismatches), m_queries(queries)
+    {
+    }
+
+    auto get_initial_state() -> State override
+    {
+      return {0};
+    }
+
+    auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    [[nodiscard]] auto get_state_storage() const -> fixpoint::StateStorage override
+    {
+      return m_storage;
+    }
+
+    auto merge(Ref<State> current, Ref<State> incoming) -> State override
+    {
+      return {std::max(current.count, incoming.count)};
+    }
+
+    auto transfer(const fixpoint::Stmt *stmt, MutRef<State> state) -> void override
+    {
+      if (!is_replaying())
+        m_seen.emplace_back(stmt, state.count);
+
+      state.count++;
+    }
+
+    auto on_function_solved(const fixpoint::FunctionDecl *func) -> void override
+    {
+      AU_UNUSED(func);
+
+      // Backwards, so the replay cursor has to restart for every block.
+      for (auto it = m_seen.rbegin(); it != m_seen.rend(); ++it)
+      {
+        const auto state = get_state_before(it->first);
+        (*m_queries)++;
+        if (!state || state->count != it->second)
+          (*m_mismatches)++;
+      }
+
+      m_seen.clear();
+    }
+  };
+
+  class TransferCounter : public fixpoint::DataFlowSolver<State>
+  {
+    fixpoint::CFGOptions m_cfg_options;
+
+public:
+    Arc<i32> m_transfers;
+    Arc<i32> m_calls;
+
+    TransferCounter(Ref<fixpoint::CFGOptions> options, Arc<i32> transfers, Arc<i32> calls)
+        : m_cfg_options(options), m_transfers(transfers), m_calls(calls)
+    {
+    }
+
+    auto get_initial_state() -> State override
+    {
+      return {0};
+    }
+
+    auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    [[nodiscard]] auto get_cfg_options() const -> fixpoint::CFGOptions override
+    {
+      return m_cfg_options;
+    }
+
+    auto merge(Ref<State> current, Ref<State> incoming) -> State override
+    {
+      return {std::max(current.count, incoming.count)};
+    }
+
+    auto transfer(const fixpoint::Stmt *stmt, MutRef<State> state) -> void override
+    {
+      AU_UNUSED(state);
+
+      (*m_transfers)++;
+      if (llvm::isa<fixpoint::CallExpr>(stmt))
+        (*m_calls)++;
+    }
+  };
+
+  // Counts statements along a path, without a ceiling: loops never converge on their own.
+  struct Counter
+  {
+    i64 value = 0;
+    bool top = false;
+
+    auto operator==(const Counter &o) const -> bool
+    {
+      return value == o.value && top == o.top;
+    }
+  };
+
+  struct CounterResults
+  {
+    std::optional<Counter> at_return;
+    i32 narrowings = 0;
+    fixpoint::DataFlowStats stats;
+  };
+
+  class UnboundedCounter : public fixpoint::DataFlowSolver<Counter>
+  {
+    bool m_widen;
+    fixpoint::DataFlowLimits m_limits;
+
+public:
+    Arc<CounterResults> m_results;
+
+    UnboundedCounter(bool widen, Ref<fixpoint::DataFlowLimits> limits, Arc<CounterResults> results)
+        : m_widen(widen), m_limits(limits), m_results(results)
+    {
+    }
+
+    auto get_initial_state() -> Counter override
+    {
+      return {};
+    }
+
+    auto get_fallback_state() -> Counter override
+    {
+      return {0, true};
+    }
+
+    auto get_limits() const -> fixpoint::DataFlowLimits override
+    {
+      return m_limits;
+    }
+
+    auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    auto merge(Ref<Counter> current, Ref<Counter> incoming) -> Counter override
+    {
+      if (current.top || incoming.top)
+        return {0, true};
+      return {std::max(current.value, incoming.value), false};
+    }
+
+    auto widen_into(MutRef<Counter> target, Ref<Counter> incoming) -> bool override
+    {
+      if (!m_widen)
+        return join_into(target, incoming);
+
+      if (target.top || (!incoming.top && incoming.value <= target.value))
+        return false;
+
+      target = {0, true};
+      return true;
+    }
+
+    auto narrow_into(MutRef<Counter> target, Ref<Counter> recomputed) -> bool override
+    {
+      m_results->narrowings++;
+      return DataFlowSolver::narrow_into(target, recomputed);
+    }
+
+    auto transfer(const fixpoint::Stmt *stmt, MutRef<Counter> state) -> void override
+    {
+      AU_UNUSED(stmt);
+
+      if (!state.top)
+        state.value++;
+    }
+
+    auto on_function_solved(const fixpoint::FunctionDecl *func) -> void override
+    {
+      const auto *body = llvm::cast<clang::CompoundStmt>(func->getBody());
+      m_results->at_return = get_state_before(body->body_back());
+      m_results->stats = get_stats();
+    }
+  };
+
+  // Variables that are read later on. A declaration kills its variable, a reference to it gens it.
+  using LiveSet = std::set<const clang::VarDecl *>;
+
+  struct LivenessResults
+  {
+    std::optional<std::set<std::string>> after_first_stmt;
+    fixpoint::DataFlowStats stats;
+  };
+
+  class LiveVariables : public fixpoint::BackwardDataFlowSolver<LiveSet>
+  {
+public:
+    Arc<LivenessResults> m_results;
+
+    LiveVariables(Arc<LivenessResults> results) : m_results(results)
+    {
+    }
+
+    auto get_initial_state() -> LiveSet override
+    {
+      return {};
+    }
+
+    auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    auto merge(Ref<LiveSet> current, Ref<LiveSet> incoming) -> LiveSet override
+    {
+      LiveSet merged = current;
+      merged.insert(incoming.begin(), incoming.end());
+      return merged;
+    }
+
+    auto transfer(const fixpoint::Stmt *stmt, MutRef<LiveSet> state) -> void override
+    {
+      if (const auto *ref = llvm::dyn_cast<clang::DeclRefExpr>(stmt))
+      {
+        if (const auto *var = llvm::dyn_cast<clang::VarDecl>(ref->getDecl()))
+          state.insert(var);
+      }
+      else if (const auto *decl_stmt = llvm::dyn_cast<clang::DeclStmt>(stmt))
+      {
+        for (const auto *decl : decl_stmt->decls())
+        {
+          if (const auto *var = llvm::dyn_cast<clang::VarDecl>(decl))
+            state.erase(var);
+        }
+      }
+    }
+
+    auto on_function_solved(const fixpoint::FunctionDecl *func) -> void override
+    {
+      const auto *body = llvm::cast<clang::CompoundStmt>(func->getBody());
+      if (auto live = get_state_before(body->body_front()))
+      {
+        m_results->after_first_stmt.emplace();
+        for (const auto *var : *live)
+          m_results->after_first_stmt->insert(var->getNameAsString());
+      }
+      m_results->stats = get_stats();
+    }
+  };
+
+  struct SolvedFunction
+  {
+    std::string name;
+    std::optional<Counter> at_return;
+
+    auto operator==(const SolvedFunction &o) const -> bool = default;
+  };
+
+  // Counts statements up to a ceiling, with no side effects in the lattice hooks so solves can run concurrently.
+  class ParallelCounter : public fixpoint::DataFlowSolver<Counter>
+  {
+    u32 m_jobs;
+
+public:
+    static constexpr i64 CEILING = 50;
+    Arc<Vec<SolvedFunction>> m_solved;
+
+    ParallelCounter(u32 jobs, Arc<Vec<SolvedFunction>> solved) : m_jobs(jobs), m_solved(solved)
+    {
+    }
+
+    auto get_initial_state() -> Counter override
+    {
+      return {};
+    }
+
+    auto get_solve_jobs() const -> u32 override
+    {
+      return m_jobs;
+    }
+
+    auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::translationUnitDecl();
+    }
+
+    auto merge(Ref<Counter> current, Ref<Counter> incoming) -> Counter override
+    {
+      return {std::max(current.value, incoming.value), false};
+    }
+
+    auto transfer(const fixpoint::Stmt *stmt, MutRef<Counter> state) -> void override
+    {
+      AU_UNUSED(stmt);
+
+      state.value = std::min(state.value + 1, CEILING);
+    }
+
+    auto on_function_solved(const fixpoint::FunctionDecl *func) -> void override
+    {
+      const auto *body = llvm::cast<clang::CompoundStmt>(func->getBody());
+      m_solved->push_back({func->getNameAsString(), get_state_before(body->body_back())});
+    }
+  };
 } // namespace
 
 IAT_BEGIN_BLOCK(Core, DataFlowSolver)
@@ -104,9 +454,287 @@ auto test_solver_convergence() -> bool
   return true;
 }
 
+auto test_reverse_post_order_visits() -> bool
+{
+  const std::string code = R"(
+        int branches(int a) {
+            int b = 0;
+            if (a > 1)
+                b = 1;
+            else if (a < -1)
+                b = 2;
+            return b;
+        }
+    )";
+
+  fixpoint::Workload workload;
+  workload.add_task(make_box<SaturatingSolver>(std::make_shared<int>(0)));
+
+  IAT_CHECK(run_workload_on_code(code, workload, [](fixpoint::ToolSettings &) {}));
+
+  const auto &stats = static_cast<const SaturatingSolver &>(*workload.get_tasks().front()).get_stats();
+
+  // Without back edges every predecessor is final by the time a block is visited, so each block runs once.
+  IAT_CHECK_EQ(stats.functions, 1u);
+  IAT_CHECK(stats.blocks > 0);
+  IAT_CHECK_EQ(stats.block_visits, stats.blocks);
+
+  return true;
+}
+
+auto test_in_place_join() -> bool
+{
+  const std::string code = R"(
+        void loop_func() {
+            for(int i=0; i<100; ++i) {
+                int x = i;
+            }
+        }
+    )";
+
+  auto result_val = std::make_shared<int>(0);
+  auto joins = std::make_shared<int>(0);
+
+  IAT_CHECK(run_test_on_code(code, InPlaceSaturatingSolver(result_val, joins)));
+
+  IAT_CHECK_EQ(*result_val, 5);
+  IAT_CHECK(*joins > 0);
+
+  return true;
+}
+
+auto test_lean_state_storage() -> bool
+{
+  const std::string code = R"(
+        int lean(int c) {
+            int r = 0;
+            for (int i = 0; i < c; ++i) {
+                if (i % 2)
+                    r += i;
+                else
+                    r -= 1;
+                r *= 2;
+            }
+            return r;
+        }
+    )";
+
+  const auto solve = [&](Box<SaturatingSolver> solver) -> fixpoint::DataFlowStats {
+    fixpoint::Workload workload;
+    workload.add_task(std::move(solver));
+
+    if (!run_workload_on_code(code, workload, [](fixpoint::ToolSettings &) {}))
+      return {};
+
+    return static_cast<const SaturatingSolver &>(*workload.get_tasks().front()).get_stats();
+  };
+
+  auto dense_max = std::make_shared<int>(0);
+  auto lean_max = std::make_shared<int>(0);
+
+  const auto dense = solve(make_box<SaturatingSolver>(dense_max));
+  const auto lean = solve(make_box<LeanSaturatingSolver>(lean_max));
+
+  IAT_CHECK_EQ(dense.functions, 1u);
+  IAT_CHECK_EQ(lean.functions, 1u);
+  IAT_CHECK_EQ(dense.stored_states, dense.blocks);
+  IAT_CHECK(lean.stored_states < lean.blocks);
+  IAT_CHECK_EQ(*dense_max, *lean_max);
+
+  return true;
+}
+
+auto test_state_queries() -> bool
+{
+  const std::string code = R"(
+        int query(int c) {
+            int r = 1;
+            if (c > 2) {
+                r = 2;
+                if (c > 4)
+                    r = 3;
+            } else {
+                r = 4;
+            }
+            r += c;
+            return r;
+        }
+    )";
+
+  for (const auto storage : {fixpoint::StateStorage::AllBlocks, fixpoint::StateStorage::JoinPoints})
+  {
+    auto mismatches = std::make_shared<i32>(0);
+    auto queries = std::make_shared<i32>(0);
+
+    IAT_CHECK(run_test_on_code(code, StateQuerySolver(storage, mismatches, queries)));
+
+    IAT_CHECK(*queries > 0);
+    IAT_CHECK_EQ(*mismatches, 0);
+  }
+
+  return true;
+}
+
+auto test_cfg_granularity() -> bool
+{
+  const std::string code = R"(
+        int helper(int v) { return v * 2; }
+
+        int granular(int a, int b) {
+            int c = helper(a + b) + helper(a - b);
+            return c * (a + 1);
+        }
+    )";
+
+  const auto count = [&](Ref<fixpoint::CFGOptions> options) -> std::pair<i32, i32> {
+    auto transfers = std::make_shared<i32>(0);
+    auto calls = std::make_shared<i32>(0);
+
+    if (!run_test_on_code(code, TransferCounter(options, transfers, calls)))
+      return {-1, -1};
+
+    return {*transfers, *calls};
+  };
+
+  fixpoint::CFGOptions all;
+
+  fixpoint::CFGOptions statements;
+  statements.granularity = fixpoint::CFGGranularity::Statements;
+
+  fixpoint::CFGOptions statements_and_calls = statements;
+  statements_and_calls.stmt_classes.set(clang::Stmt::CallExprClass);
+
+  const auto [all_transfers, all_calls] = count(all);
+  const auto [statement_transfers, statement_calls] = count(statements);
+  const auto [selected_transfers, selected_calls] = count(statements_and_calls);
+
+  IAT_CHECK(statement_transfers > 0);
+  IAT_CHECK(statement_transfers < all_transfers);
+  IAT_CHECK_EQ(all_calls, 2);
+  IAT_CHECK_EQ(statement_calls, 0);
+  IAT_CHECK_EQ(selected_calls, 2);
+  IAT_CHECK(selected_transfers < all_transfers);
+
+  return true;
+}
+
+auto test_widening_at_loop_heads() -> bool
+{
+  const std::string code = R"(
+        int widen(int n) {
+            int total = 0;
+            while (n > 0) {
+                total += n;
+                n--;
+            }
+            return total;
+        }
+    )";
+
+  auto results = std::make_shared<CounterResults>();
+  const fixpoint::DataFlowLimits limits{.narrowing_passes = 2};
+  IAT_CHECK(run_test_on_code(code, UnboundedCounter(true, limits, results)));
+
+  IAT_CHECK(results->at_return.has_value());
+  IAT_CHECK(results->at_return->top);
+  IAT_CHECK(results->narrowings > 0);
+  IAT_CHECK_EQ(results->stats.budget_exhausted, 0u);
+
+  return true;
+}
+
+auto test_iteration_budget() -> bool
+{
+  const std::string code = R"(
+        int budget(int n) {
+            int total = 0;
+            while (n > 0) {
+                total += n;
+                n--;
+            }
+            return total;
+        }
+    )";
+
+  auto results = std::make_shared<CounterResults>();
+  const fixpoint::DataFlowLimits limits{.iteration_budget = 200};
+  IAT_CHECK(run_test_on_code(code, UnboundedCounter(false, limits, results)));
+
+  IAT_CHECK_EQ(results->stats.budget_exhausted, 1u);
+  IAT_CHECK(results->stats.block_visits <= 200u);
+  IAT_CHECK(results->at_return.has_value());
+  IAT_CHECK(results->at_return->top);
+
+  return true;
+}
+
+auto test_backward_liveness() -> bool
+{
+  const std::string code = R"(
+        int live(int n) {
+            int unused = 1;
+            int sum = 0;
+            for (int i = 0; i < n; ++i)
+                sum += i;
+            return sum;
+        }
+    )";
+
+  auto results = std::make_shared<LivenessResults>();
+  IAT_CHECK(run_test_on_code(code, LiveVariables(results)));
+
+  // `n` is only read by the loop condition, so it has to flow back through the loop to reach the first statement.
+  IAT_CHECK(results->after_first_stmt.has_value());
+  IAT_CHECK(*results->after_first_stmt == std::set<std::string>{"n"});
+
+  // Post-order only revisits the blocks of the loop.
+  IAT_CHECK_EQ(results->stats.functions, 1u);
+  IAT_CHECK(results->stats.block_visits < 2 * results->stats.blocks);
+
+  return true;
+}
+
+auto test_parallel_solves() -> bool
+{
+  std::string code;
+  for (i32 i = 0; i < 300; ++i)
+  {
+    code += std::format("int func_{0}(int n) {{\n"
+                        "  int total = {0};\n"
+                        "  for (int i = 0; i < n % {1}; ++i)\n"
+                        "    total += i;\n"
+                        "  return total;\n"
+                        "}}\n",
+                        i, i % 7 + 1);
+  }
+
+  auto sequential = std::make_shared<Vec<SolvedFunction>>();
+  auto parallel = std::make_shared<Vec<SolvedFunction>>();
+
+  IAT_CHECK(run_test_on_code(code, ParallelCounter(1, sequential)));
+  IAT_CHECK(run_test_on_code(code, ParallelCounter(4, parallel)));
+
+  // Functions are delivered in source order with the same states, however the solves were scheduled.
+  IAT_CHECK_EQ(sequential->size(), 300u);
+  IAT_CHECK(*sequential == *parallel);
+  IAT_CHECK_EQ(parallel->front().name, std::string("func_0"));
+  IAT_CHECK(parallel->back().at_return.has_value());
+
+  return true;
+}
+
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_solver_execution);
 IAT_ADD_TEST(test_solver_convergence);
+IAT_ADD_TEST(test_reverse_post_order_visits);
+IAT_ADD_TEST(test_in_place_join);
+IAT_ADD_TEST(test_lean_state_storage);
+IAT_ADD_TEST(test_state_queries);
+IAT_ADD_TEST(test_cfg_granularity);
+IAT_ADD_TEST(test_widening_at_loop_heads);
+IAT_ADD_TEST(test_iteration_budget);
+IAT_ADD_TEST(test_backward_liveness);
+IAT_ADD_TEST(test_parallel_solves);
 IAT_END_TEST_LIST()
 
 IAT_END_BLOCK()
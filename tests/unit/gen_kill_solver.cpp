@@ -0,0 +1,181 @@
+// Fixpoint: Powerful static analysis, simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "helpers.hpp"
+
+#include <map>
+
+using namespace ia;
+
+namespace
+{
+  class VarIndexer : public clang::RecursiveASTVisitor<VarIndexer>
+  {
+public:
+    std::map<const fixpoint::VarDecl *, u32> indices;
+
+    auto VisitVarDecl(fixpoint::VarDecl *var) -> bool
+    {
+      indices.emplace(var, static_cast<u32>(indices.size()));
+      return true;
+    }
+  };
+
+  // Must analysis: a local is initialized if every path to a statement assigns it.
+  class InitializedVariables : public fixpoint::GenKillSolver
+  {
+    VarIndexer m_indexer;
+
+public:
+    // Per variable name, whether it was initialized at the (last) return statement.
+    Arc<std::map<std::string, bool>> at_return;
+
+    InitializedVariables(Arc<std::map<std::string, bool>> results) : at_return(results)
+    {
+    }
+
+    [[nodiscard]] auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    [[nodiscard]] auto get_join() const -> fixpoint::GenKillJoin override
+    {
+      return fixpoint::GenKillJoin::Intersection;
+    }
+
+    [[nodiscard]] auto get_fact_count(const fixpoint::FunctionDecl *func) -> u32 override
+    {
+      m_indexer.indices.clear();
+      m_indexer.TraverseStmt(func->getBody());
+      return static_cast<u32>(m_indexer.indices.size());
+    }
+
+    auto gen_kill(const fixpoint::Stmt *stmt, MutRef<fixpoint::FactSet> gen, MutRef<fixpoint::FactSet> kill)
+        -> void override
+    {
+      AU_UNUSED(kill);
+
+      if (const auto *decl_stmt = llvm::dyn_cast<clang::DeclStmt>(stmt))
+      {
+        for (const auto *decl : decl_stmt->decls())
+        {
+          const auto *var = llvm::dyn_cast<fixpoint::VarDecl>(decl);
+          if (var && var->hasInit())
+            gen.set(m_indexer.indices.at(var));
+        }
+      }
+      else if (const auto *op = llvm::dyn_cast<fixpoint::BinaryOperator>(stmt); op && op->isAssignmentOp())
+      {
+        const auto *ref = llvm::dyn_cast<fixpoint::DeclRefExpr>(op->getLHS()->IgnoreParenImpCasts());
+        const auto *var = ref ? llvm::dyn_cast<fixpoint::VarDecl>(ref->getDecl()) : nullptr;
+        if (var && m_indexer.indices.contains(var))
+          gen.set(m_indexer.indices.at(var));
+      }
+    }
+
+    auto on_statement(const fixpoint::Stmt *stmt, Ref<fixpoint::FactSet> state) -> void override
+    {
+      if (!llvm::isa<fixpoint::ReturnStmt>(stmt))
+        return;
+
+      for (const auto &[var, index] : m_indexer.indices)
+        (*at_return)[var->getNameAsString()] = state.test(index);
+    }
+  };
+} // namespace
+
+IAT_BEGIN_BLOCK(Core, GenKillSolver)
+
+auto test_fact_set_operations() -> bool
+{
+  fixpoint::FactSet a(70);
+  fixpoint::FactSet b(70);
+
+  a.set(1);
+  a.set(69);
+  b.set(69);
+
+  IAT_CHECK(!a.union_with(b));
+  IAT_CHECK(b.union_with(a));
+  IAT_CHECK(a == b);
+
+  b.reset(1);
+  IAT_CHECK(a.intersect_with(b));
+  IAT_CHECK_EQ(a.count(), 1u);
+  IAT_CHECK(a.test(69));
+
+  a.subtract(b);
+  IAT_CHECK_EQ(a.count(), 0u);
+
+  IAT_CHECK_EQ(fixpoint::FactSet(70, true).count(), 70u);
+
+  return true;
+}
+
+auto test_initialized_variables() -> bool
+{
+  const std::string code = R"(
+        int partial(int c) {
+            int a = 1;
+            int b;
+            if (c)
+                b = 2;
+            return a + b;
+        }
+    )";
+
+  auto results = std::make_shared<std::map<std::string, bool>>();
+  IAT_CHECK(run_test_on_code(code, InitializedVariables(results)));
+
+  IAT_CHECK((*results)["a"]);
+  IAT_CHECK(!(*results)["b"]);
+
+  return true;
+}
+
+auto test_initialized_on_all_paths() -> bool
+{
+  const std::string code = R"(
+        int all_paths(int c) {
+            int a;
+            for (int i = 0; i < c; ++i)
+                c--;
+            if (c)
+                a = 1;
+            else
+                a = 2;
+            return a;
+        }
+    )";
+
+  auto results = std::make_shared<std::map<std::string, bool>>();
+  IAT_CHECK(run_test_on_code(code, InitializedVariables(results)));
+
+  IAT_CHECK((*results)["a"]);
+  IAT_CHECK((*results)["i"]);
+
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_fact_set_operations);
+IAT_ADD_TEST(test_initialized_variables);
+IAT_ADD_TEST(test_initialized_on_all_paths);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, GenKillSolver)
@@ -23,34 +23,69 @@
 
 namespace ia::fixpoint
 {
-  template<typename TaskT> auto run_test_on_code(const std::string &code, TaskT &&task) -> bool
+  template<typename ConfigureT>
+  auto run_workload_on_sources(const std::vector<std::string> &sources, Workload &workload, ConfigureT &&configure)
+      -> Result<RunReport>
   {
-    const std::string filename = "temp_fixpoint_test.cpp";
+    std::vector<std::string> filenames;
+    for (size_t i = 0; i < sources.size(); ++i)
     {
-      std::ofstream out(filename);
-      out << code;
+      filenames.push_back(i ? std::format("temp_fixpoint_test_{}.cpp", i) : "temp_fixpoint_test.cpp");
+
+      std::ofstream out(filenames.back());
+      out << sources[i];
     }
 
-    const char *argv[] = {"fixpoint_test", filename.c_str(), "--", "-std=c++20"};
-    int argc = 4;
+    std::vector<const char *> argv = {"fixpoint_test"};
+    for (const auto &filename : filenames)
+      argv.push_back(filename.c_str());
+    argv.push_back("--");
+    argv.push_back("-std=c++20");
+
+    const auto cleanup = [&] {
+      for (const auto &filename : filenames)
+        std::filesystem::remove(filename);
+    };
 
-    auto options = fixpoint::Options::create("Test", argc, argv);
+    auto options = fixpoint::Options::create("Test", static_cast<int>(argv.size()), argv.data());
     if (!options)
-      return false;
+    {
+      cleanup();
+      return fail("{}", options.error());
+    }
+
+    configure(options->get_settings());
 
     auto db = fixpoint::CompileDB::create(*options);
     if (!db)
-      return false;
+    {
+      cleanup();
+      return fail("{}", db.error());
+    }
 
     auto tool = fixpoint::Tool::create(*options, *db);
     if (!tool)
-      return false;
+    {
+      cleanup();
+      return fail("{}", tool.error());
+    }
 
+    auto res = (*tool)->run(workload);
+    cleanup();
+    return res;
+  }
+
+  template<typename ConfigureT>
+  auto run_workload_on_code(const std::string &code, Workload &workload, ConfigureT &&configure) -> bool
+  {
+    return run_workload_on_sources({code}, workload, std::forward<ConfigureT>(configure)).has_value();
+  }
+
+  template<typename TaskT> auto run_test_on_code(const std::string &code, TaskT &&task) -> bool
+  {
     fixpoint::Workload workload;
     workload.add_task(std::make_unique<TaskT>(std::move(task)));
 
-    auto res = (*tool)->run(workload);
-    std::filesystem::remove(filename);
-    return res.has_value();
+    return run_workload_on_code(code, workload, [](ToolSettings &) {});
   }
 } // namespace ia::fixpoint
\ No newline at end of file
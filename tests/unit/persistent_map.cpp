@@ -0,0 +1,198 @@
+// Fixpoint: Powerful static analysis, simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "helpers.hpp"
+
+using namespace ia;
+
+namespace
+{
+  using IntMap = fixpoint::PersistentMap<i32, i32>;
+
+  static_assert(fixpoint::DataFlowState<IntMap>);
+
+  auto max_join(Ref<i32> current, Ref<i32> incoming) -> i32
+  {
+    return std::max(current, incoming);
+  }
+
+  // Tracks, per local variable, the number of times it was assigned along the longest path (capped).
+  class AssignmentCounter : public fixpoint::DataFlowSolver<fixpoint::PersistentMap<std::string, i32>>
+  {
+public:
+    using State = fixpoint::PersistentMap<std::string, i32>;
+
+    Arc<State> m_final;
+
+    AssignmentCounter(Arc<State> final_state) : m_final(final_state)
+    {
+    }
+
+    [[nodiscard]] auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    [[nodiscard]] auto get_initial_state() -> State override
+    {
+      return {};
+    }
+
+    [[nodiscard]] auto merge(Ref<State> current, Ref<State> incoming) -> State override
+    {
+      State result = current;
+      result.join_with(incoming, max_join);
+      return result;
+    }
+
+    auto join_into(MutRef<State> target, Ref<State> incoming) -> bool override
+    {
+      return target.join_with(incoming, max_join);
+    }
+
+    auto transfer(const fixpoint::Stmt *stmt, MutRef<State> state) -> void override
+    {
+      const auto *op = llvm::dyn_cast<fixpoint::BinaryOperator>(stmt);
+      if (!op || !op->isAssignmentOp())
+        return;
+
+      const auto *ref = llvm::dyn_cast<fixpoint::DeclRefExpr>(op->getLHS()->IgnoreParenImpCasts());
+      if (!ref)
+        return;
+
+      const auto name = ref->getDecl()->getNameAsString();
+      const auto *count = state.find(name);
+      state.set(name, std::min((count ? *count : 0) + 1, 3));
+
+      *m_final = state;
+    }
+  };
+} // namespace
+
+IAT_BEGIN_BLOCK(Core, PersistentMap)
+
+auto test_set_find_erase() -> bool
+{
+  IntMap map;
+  for (i32 i = 0; i < 100; ++i)
+    map.set(i, i * i);
+
+  IAT_CHECK_EQ(map.size(), 100u);
+  IAT_CHECK(map.find(7) && *map.find(7) == 49);
+  IAT_CHECK(!map.find(100));
+
+  map.erase(7);
+  IAT_CHECK_EQ(map.size(), 99u);
+  IAT_CHECK(!map.contains(7));
+
+  std::vector<i32> keys;
+  map.for_each([&](Ref<i32> key, Ref<i32> value) {
+    AU_UNUSED(value);
+    keys.push_back(key);
+  });
+  IAT_CHECK(std::ranges::is_sorted(keys));
+  IAT_CHECK_EQ(keys.size(), 99u);
+
+  return true;
+}
+
+auto test_copies_are_independent() -> bool
+{
+  IntMap original;
+  for (i32 i = 0; i < 32; ++i)
+    original.set(i, 0);
+
+  IntMap copy = original;
+  IAT_CHECK(copy == original);
+
+  copy.set(5, 1);
+  IAT_CHECK(!(copy == original));
+  IAT_CHECK_EQ(*original.find(5), 0);
+  IAT_CHECK_EQ(*copy.find(5), 1);
+
+  copy.set(5, 0);
+  IAT_CHECK(copy == original);
+
+  return true;
+}
+
+auto test_shape_is_canonical() -> bool
+{
+  IntMap forward;
+  IntMap backward;
+  for (i32 i = 0; i < 64; ++i)
+  {
+    forward.set(i, i);
+    backward.set(63 - i, 63 - i);
+  }
+
+  IAT_CHECK(forward == backward);
+
+  return true;
+}
+
+auto test_join_with() -> bool
+{
+  IntMap a;
+  a.set(1, 10);
+  a.set(2, 20);
+
+  IntMap b;
+  b.set(2, 5);
+  b.set(3, 30);
+
+  IAT_CHECK(a.join_with(b, max_join));
+  IAT_CHECK_EQ(a.size(), 3u);
+  IAT_CHECK_EQ(*a.find(2), 20);
+  IAT_CHECK_EQ(*a.find(3), 30);
+
+  // Joining a subset changes nothing.
+  IAT_CHECK(!a.join_with(b, max_join));
+
+  return true;
+}
+
+auto test_as_data_flow_state() -> bool
+{
+  const std::string code = R"(
+        void assign(int c) {
+            int a = 0;
+            int b = 0;
+            a = 1;
+            if (c)
+                b = 1;
+            a = 2;
+        }
+    )";
+
+  auto final_state = std::make_shared<AssignmentCounter::State>();
+  IAT_CHECK(run_test_on_code(code, AssignmentCounter(final_state)));
+
+  IAT_CHECK(final_state->find("a") && *final_state->find("a") == 2);
+
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_set_find_erase);
+IAT_ADD_TEST(test_copies_are_independent);
+IAT_ADD_TEST(test_shape_is_canonical);
+IAT_ADD_TEST(test_join_with);
+IAT_ADD_TEST(test_as_data_flow_state);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, PersistentMap)
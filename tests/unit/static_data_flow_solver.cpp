@@ -0,0 +1,173 @@
+// Fixpoint: Powerful static analysis, simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "helpers.hpp"
+
+using namespace ia;
+
+namespace
+{
+  struct State
+  {
+    i32 count = 0;
+
+    auto operator==(const State &o) const -> bool
+    {
+      return count == o.count;
+    }
+  };
+
+  class StaticSaturatingSolver : public fixpoint::StaticDataFlowSolver<StaticSaturatingSolver, State>
+  {
+public:
+    static constexpr i32 SATURATION_LIMIT = 5;
+    Arc<i32> m_max_value_reached;
+
+    StaticSaturatingSolver(Arc<i32> ptr) : m_max_value_reached(ptr)
+    {
+    }
+
+    auto get_initial_state() -> State
+    {
+      return {0};
+    }
+
+    auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    auto merge(Ref<State> current, Ref<State> incoming) -> State
+    {
+      return {std::max(current.count, incoming.count)};
+    }
+
+    auto transfer(const fixpoint::Stmt *stmt, MutRef<State> state) -> void
+    {
+      AU_UNUSED(stmt);
+
+      if (state.count < SATURATION_LIMIT)
+        state.count++;
+      *m_max_value_reached = std::max(*m_max_value_reached, state.count);
+    }
+  };
+
+  struct DispatchCounts
+  {
+    i32 binary_operators = 0;
+    i32 compound_assignments = 0;
+    i32 calls = 0;
+  };
+
+  // Only typed overloads, no catch-all: every other statement class must be skipped.
+  class TypedTransferSolver : public fixpoint::StaticDataFlowSolver<TypedTransferSolver, State>
+  {
+public:
+    Arc<DispatchCounts> m_counts;
+
+    TypedTransferSolver(Arc<DispatchCounts> counts) : m_counts(counts)
+    {
+    }
+
+    auto get_initial_state() -> State
+    {
+      return {0};
+    }
+
+    auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    auto merge(Ref<State> current, Ref<State> incoming) -> State
+    {
+      return {std::max(current.count, incoming.count)};
+    }
+
+    auto transfer(const fixpoint::BinaryOperator *op, MutRef<State> state) -> void
+    {
+      AU_UNUSED(op);
+      AU_UNUSED(state);
+      m_counts->binary_operators++;
+    }
+
+    auto transfer(const clang::CompoundAssignOperator *op, MutRef<State> state) -> void
+    {
+      AU_UNUSED(op);
+      AU_UNUSED(state);
+      m_counts->compound_assignments++;
+    }
+
+    auto transfer(const fixpoint::CallExpr *call, MutRef<State> state) -> void
+    {
+      AU_UNUSED(call);
+      AU_UNUSED(state);
+      m_counts->calls++;
+    }
+  };
+} // namespace
+
+IAT_BEGIN_BLOCK(Core, StaticDataFlowSolver)
+
+auto test_static_solver_convergence() -> bool
+{
+  const std::string code = R"(
+        void loop_func() {
+            for(int i=0; i<100; ++i) {
+                int x = i;
+            }
+        }
+    )";
+
+  auto result_val = std::make_shared<int>(0);
+
+  IAT_CHECK(run_test_on_code(code, StaticSaturatingSolver(result_val)));
+  IAT_CHECK_EQ(*result_val, 5);
+
+  return true;
+}
+
+auto test_typed_dispatch() -> bool
+{
+  const std::string code = R"(
+        int helper(int v) { return v; }
+
+        int dispatch(int a) {
+            int b = a + 1;
+            b += helper(a);
+            b -= 2;
+            return b;
+        }
+    )";
+
+  auto counts = std::make_shared<DispatchCounts>();
+
+  IAT_CHECK(run_test_on_code(code, TypedTransferSolver(counts)));
+
+  IAT_CHECK_EQ(counts->binary_operators, 1);
+  IAT_CHECK_EQ(counts->compound_assignments, 2);
+  IAT_CHECK_EQ(counts->calls, 1);
+
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_static_solver_convergence);
+IAT_ADD_TEST(test_typed_dispatch);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, StaticDataFlowSolver)
@@ -0,0 +1,757 @@
+// Fixpoint: Powerful static analysis, simplified.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "helpers.hpp"
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+
+using namespace ia;
+
+namespace
+{
+  struct ContextLog
+  {
+    std::vector<const clang::ASTContext *> contexts;
+  };
+
+  class ContextRecorder : public fixpoint::IWorkloadTask
+  {
+    Arc<ContextLog> m_log;
+
+public:
+    ContextRecorder(Arc<ContextLog> log) : m_log(log)
+    {
+    }
+
+    [[nodiscard]] auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::translationUnitDecl();
+    }
+
+    auto run(Ref<fixpoint::MatchResult> result) -> void override
+    {
+      m_log->contexts.push_back(result.Context);
+    }
+  };
+
+  class VarCollector : public fixpoint::IWorkloadTask
+  {
+public:
+    std::vector<std::string> names;
+
+    [[nodiscard]] auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::varDecl();
+    }
+
+    auto run(Ref<fixpoint::MatchResult> result) -> void override
+    {
+      if (const auto *var = result.Nodes.getNodeAs<fixpoint::VarDecl>("decl"))
+        names.push_back(var->getNameAsString());
+    }
+
+    [[nodiscard]] auto clone() const -> Box<fixpoint::IWorkloadTask> override
+    {
+      return make_box<VarCollector>();
+    }
+
+    auto merge_from(MutRef<fixpoint::IWorkloadTask> other) -> void override
+    {
+      auto &collector = static_cast<VarCollector &>(other);
+      names.insert(names.end(), collector.names.begin(), collector.names.end());
+    }
+
+    [[nodiscard]] auto export_results() const -> String override
+    {
+      String blob;
+      for (const auto &name : names)
+        blob += name + "\n";
+      return blob;
+    }
+
+    auto import_results(fixpoint::LLVM_StringRef data) -> void override
+    {
+      llvm::SmallVector<fixpoint::LLVM_StringRef> lines;
+      data.split(lines, '\n', -1, false);
+      for (const auto line : lines)
+        names.push_back(line.str());
+    }
+  };
+
+  class PrefilteredVarCollector : public VarCollector
+  {
+    std::vector<std::string> m_globs;
+    std::vector<std::string> m_tokens;
+
+public:
+    PrefilteredVarCollector(std::vector<std::string> globs, std::vector<std::string> tokens)
+        : m_globs(std::move(globs)), m_tokens(std::move(tokens))
+    {
+    }
+
+    [[nodiscard]] auto get_path_globs() const -> std::vector<std::string> override
+    {
+      return m_globs;
+    }
+
+    [[nodiscard]] auto get_required_tokens() const -> std::vector<std::string> override
+    {
+      return m_tokens;
+    }
+
+    [[nodiscard]] auto clone() const -> Box<fixpoint::IWorkloadTask> override
+    {
+      return make_box<PrefilteredVarCollector>(m_globs, m_tokens);
+    }
+  };
+
+  class CachedVarCollector : public VarCollector
+  {
+public:
+    [[nodiscard]] auto get_cache_version() const -> std::string override
+    {
+      return "1";
+    }
+
+    [[nodiscard]] auto clone() const -> Box<fixpoint::IWorkloadTask> override
+    {
+      return make_box<CachedVarCollector>();
+    }
+  };
+
+  class FunctionPolice : public fixpoint::DeclPolice
+  {
+public:
+    std::vector<std::string> names;
+
+    [[nodiscard]] auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    auto police(const fixpoint::Decl *decl, Ref<fixpoint::SourceLocation> loc) -> void override
+    {
+      AU_UNUSED(loc);
+
+      if (const auto func = fixpoint::llvm_cast<const fixpoint::FunctionDecl>(decl))
+        names.push_back(func->getNameAsString());
+    }
+  };
+
+  class HeaderBodyVarCollector : public VarCollector
+  {
+public:
+    [[nodiscard]] auto needs_header_function_bodies() const -> bool override
+    {
+      return true;
+    }
+  };
+
+  class NullSolver : public fixpoint::DataFlowSolver<i32>
+  {
+public:
+    [[nodiscard]] auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::functionDecl(fixpoint::ast::isDefinition());
+    }
+
+    [[nodiscard]] auto merge(Ref<i32> current, Ref<i32> incoming) -> i32 override
+    {
+      return std::max(current, incoming);
+    }
+
+    auto transfer(const fixpoint::Stmt *stmt, MutRef<i32> state) -> void override
+    {
+      AU_UNUSED(stmt);
+      AU_UNUSED(state);
+    }
+
+    [[nodiscard]] auto get_initial_state() -> i32 override
+    {
+      return 0;
+    }
+  };
+
+  class SolvedFunctionCollector : public NullSolver
+  {
+public:
+    std::vector<std::string> names;
+
+    auto on_function_solved(const fixpoint::FunctionDecl *func) -> void override
+    {
+      names.push_back(func->getNameAsString());
+    }
+  };
+
+#if !defined(_WIN32)
+  // Takes its worker process down (like the OOM killer would) when it sees a variable named `crash_me`.
+  class CrashingTask : public fixpoint::IWorkloadTask
+  {
+public:
+    [[nodiscard]] auto get_matcher() const -> fixpoint::DeclarationMatcher override
+    {
+      return fixpoint::ast::varDecl(fixpoint::ast::hasName("crash_me"));
+    }
+
+    auto run(Ref<fixpoint::MatchResult> result) -> void override
+    {
+      AU_UNUSED(result);
+      std::raise(SIGKILL);
+    }
+  };
+#endif
+
+  auto make_recorder_workload(Arc<ContextLog> log) -> Box<fixpoint::Workload>
+  {
+    auto workload = make_box<fixpoint::Workload>();
+    workload->add_task(make_box<ContextRecorder>(log));
+    workload->add_task(make_box<ContextRecorder>(log));
+    return workload;
+  }
+} // namespace
+
+IAT_BEGIN_BLOCK(Core, Tool)
+
+auto test_single_parse_shares_ast() -> bool
+{
+  const std::string code = "int value = 1;";
+
+  auto log = std::make_shared<ContextLog>();
+  auto workload = make_recorder_workload(log);
+
+  IAT_CHECK(fixpoint::run_workload_on_code(code, *workload,
+                                           [](fixpoint::ToolSettings &settings) { settings.single_parse = true; }));
+
+  IAT_CHECK_EQ(log->contexts.size(), 2u);
+  IAT_CHECK(log->contexts[0] == log->contexts[1]);
+
+  return true;
+}
+
+auto test_per_task_parse() -> bool
+{
+  const std::string code = "int value = 1;";
+
+  auto log = std::make_shared<ContextLog>();
+  auto workload = make_recorder_workload(log);
+
+  IAT_CHECK(fixpoint::run_workload_on_code(code, *workload,
+                                           [](fixpoint::ToolSettings &settings) { settings.single_parse = false; }));
+
+  IAT_CHECK_EQ(log->contexts.size(), 2u);
+
+  return true;
+}
+
+auto test_parallel_jobs() -> bool
+{
+  const std::vector<std::string> sources = {
+      "int a = 1;", "int b = 2;", "int c = 3;", "int d = 4;", "int e = 5;", "int f = 6;",
+  };
+
+  auto log = std::make_shared<ContextLog>();
+  auto workload = make_recorder_workload(log);
+
+  auto report = fixpoint::run_workload_on_sources(sources, *workload,
+                                                  [](fixpoint::ToolSettings &settings) { settings.jobs = 3; });
+
+  IAT_CHECK(report.has_value());
+  IAT_CHECK_EQ(report->jobs, 3u);
+  IAT_CHECK_EQ(report->translation_units, 6u);
+  IAT_CHECK_EQ(log->contexts.size(), 12u);
+
+  return true;
+}
+
+auto test_clone_reduction_is_deterministic() -> bool
+{
+  const std::vector<std::string> sources = {
+      "int a0; int a1;", "int b0;", "int c0; int c1; int c2;", "int d0;", "int e0; int e1;", "int f0;",
+  };
+
+  const auto collect = [&](u32 jobs) -> std::vector<std::string> {
+    fixpoint::Workload workload;
+    workload.add_task<VarCollector>();
+
+    const auto report = fixpoint::run_workload_on_sources(
+        sources, workload, [jobs](fixpoint::ToolSettings &settings) { settings.jobs = jobs; });
+    if (!report)
+      return {};
+
+    return static_cast<const VarCollector &>(*workload.get_tasks().front()).names;
+  };
+
+  const auto sequential = collect(1);
+  const auto parallel = collect(4);
+
+  IAT_CHECK_EQ(sequential.size(), 10u);
+  IAT_CHECK(sequential == parallel);
+
+  return true;
+}
+
+auto test_keep_going_reports_failed_files() -> bool
+{
+  const std::vector<std::string> sources = {"int a0;", "int broken = ;", "int c0;"};
+
+  fixpoint::Workload workload;
+  workload.add_task<VarCollector>();
+
+  const auto report = fixpoint::run_workload_on_sources(sources, workload, [](fixpoint::ToolSettings &settings) {
+    settings.jobs = 2;
+    settings.keep_going = true;
+  });
+
+  IAT_CHECK(report.has_value());
+  IAT_CHECK(report->failed_files == std::vector<std::string>({"temp_fixpoint_test_1.cpp"}));
+
+  const auto &names = static_cast<const VarCollector &>(*workload.get_tasks().front()).names;
+  IAT_CHECK(names == std::vector<std::string>({"a0", "c0"}));
+
+  return true;
+}
+
+auto test_keep_going_with_ast_cache() -> bool
+{
+  const std::string cache_dir = "temp_fixpoint_failed_ast_cache";
+  const std::vector<std::string> sources = {"int a0;", "int broken = ;", "int c0;"};
+
+  std::filesystem::remove_all(cache_dir);
+
+  // The second run loads the good translation units from the cache and must still report the broken one.
+  for (int run = 0; run < 2; ++run)
+  {
+    fixpoint::Workload workload;
+    workload.add_task<VarCollector>();
+
+    const auto report = fixpoint::run_workload_on_sources(sources, workload, [&](fixpoint::ToolSettings &settings) {
+      settings.jobs = 2;
+      settings.keep_going = true;
+      settings.ast_cache_dir = cache_dir;
+    });
+
+    IAT_CHECK(report.has_value());
+    IAT_CHECK(report->failed_files == std::vector<std::string>({"temp_fixpoint_test_1.cpp"}));
+    IAT_CHECK_EQ(report->ast_cache.hits, run ? 2u : 0u);
+
+    const auto &names = static_cast<const VarCollector &>(*workload.get_tasks().front()).names;
+    IAT_CHECK(names == std::vector<std::string>({"a0", "c0"}));
+  }
+
+  std::filesystem::remove_all(cache_dir);
+  return true;
+}
+
+auto test_main_file_only_scope() -> bool
+{
+  const std::string header_path = "temp_fixpoint_header.hpp";
+  {
+    std::ofstream header(header_path);
+    header << "int header_var;\n";
+  }
+
+  const std::string code = "#include \"temp_fixpoint_header.hpp\"\nint main_var;";
+
+  const auto collect = [&](bool main_file_only) -> std::vector<std::string> {
+    fixpoint::Workload workload;
+    workload.add_task<VarCollector>();
+    workload.set_main_file_only(main_file_only);
+
+    if (!fixpoint::run_workload_on_code(code, workload, [](fixpoint::ToolSettings &) {}))
+      return {};
+
+    return static_cast<const VarCollector &>(*workload.get_tasks().front()).names;
+  };
+
+  const auto full = collect(false);
+  const auto scoped = collect(true);
+
+  std::remove(header_path.c_str());
+
+  IAT_CHECK(full == std::vector<std::string>({"header_var", "main_var"}));
+  IAT_CHECK(scoped == std::vector<std::string>({"main_var"}));
+
+  return true;
+}
+
+auto test_skip_header_bodies() -> bool
+{
+  const std::string header_path = "temp_fixpoint_header.hpp";
+  {
+    std::ofstream header(header_path);
+    header << "inline int header_fn() { int header_local = 1; return header_local; }\n";
+  }
+
+  const std::string code = "#include \"temp_fixpoint_header.hpp\"\nint main_fn() { int main_local = header_fn(); "
+                           "return main_local; }";
+
+  const auto collect = [&](fixpoint::Workload &workload, bool skip) -> std::vector<std::string> {
+    const auto configure = [skip](fixpoint::ToolSettings &settings) { settings.skip_header_bodies = skip; };
+    if (!fixpoint::run_workload_on_code(code, workload, configure))
+      return {};
+
+    return static_cast<const VarCollector &>(*workload.get_tasks().front()).names;
+  };
+
+  fixpoint::Workload full;
+  full.add_task<VarCollector>();
+
+  fixpoint::Workload skipped;
+  skipped.add_task<VarCollector>();
+
+  fixpoint::Workload opted_in;
+  opted_in.add_task<HeaderBodyVarCollector>();
+
+  const auto full_names = collect(full, false);
+  const auto skipped_names = collect(skipped, true);
+  const auto opted_in_names = collect(opted_in, true);
+
+  std::remove(header_path.c_str());
+
+  IAT_CHECK(full_names == std::vector<std::string>({"header_local", "main_local"}));
+  IAT_CHECK(skipped_names == std::vector<std::string>({"main_local"}));
+  IAT_CHECK(opted_in_names == full_names);
+
+  return true;
+}
+
+auto test_cfg_cache_is_shared() -> bool
+{
+  const std::string code = "int f(int x) { return x + 1; }\nint g(int x) { if (x) return f(x); return 0; }";
+
+  fixpoint::Workload workload;
+  workload.add_task<NullSolver>();
+  workload.add_task<NullSolver>();
+  workload.add_task<NullSolver>();
+
+  const auto report = fixpoint::run_workload_on_sources({code}, workload, [](fixpoint::ToolSettings &) {});
+
+  IAT_CHECK(report.has_value());
+  IAT_CHECK_EQ(report->cfg_cache.builds, 2u);
+  IAT_CHECK_EQ(report->cfg_cache.hits, 4u);
+
+  return true;
+}
+
+auto test_task_prefilters() -> bool
+{
+  const std::string header_path = "temp_fixpoint_prefilter.hpp";
+  {
+    std::ofstream header(header_path);
+    header << "struct needle_type {};\n";
+  }
+
+  // The token only reaches the first file through its include; the second one mentions it in a comment.
+  const std::vector<std::string> sources = {
+      "#include \"temp_fixpoint_prefilter.hpp\"\nint a0;",
+      "int b0; // needle_type\n",
+      "int c0;",
+  };
+
+  fixpoint::Workload workload;
+  workload.add_task(make_box<PrefilteredVarCollector>(std::vector<std::string>{},
+                                                      std::vector<std::string>{"needle_type"}));
+  workload.add_task(make_box<PrefilteredVarCollector>(std::vector<std::string>{"*temp_fixpoint_test_2.cpp"},
+                                                      std::vector<std::string>{}));
+
+  const auto report = fixpoint::run_workload_on_sources(sources, workload, [](fixpoint::ToolSettings &) {});
+
+  fixpoint::Workload invalid;
+  invalid.add_task(make_box<PrefilteredVarCollector>(std::vector<std::string>{"src/[net"},
+                                                     std::vector<std::string>{}));
+  const auto invalid_report = fixpoint::run_workload_on_sources(sources, invalid, [](fixpoint::ToolSettings &) {});
+
+  std::remove(header_path.c_str());
+
+  IAT_CHECK(report.has_value());
+  IAT_CHECK_EQ(report->skipped_parses, 1u);
+  IAT_CHECK(static_cast<const VarCollector &>(*workload.get_tasks()[0]).names == std::vector<std::string>({"a0"}));
+  IAT_CHECK(static_cast<const VarCollector &>(*workload.get_tasks()[1]).names == std::vector<std::string>({"c0"}));
+  IAT_CHECK(!invalid_report.has_value());
+
+  return true;
+}
+
+auto test_changed_lines_mode() -> bool
+{
+  const auto parsed = fixpoint::ChangedLines::parse("--- a/src/x.cpp\n"
+                                                    "+++ b/src/x.cpp\n"
+                                                    "@@ -1,3 +1,2 @@\n"
+                                                    " a\n"
+                                                    "-b\n"
+                                                    " c\n"
+                                                    "@@ -10,2 +9,3 @@\n"
+                                                    " d\n"
+                                                    "+e\n"
+                                                    " f\n");
+  IAT_CHECK(parsed.has_value());
+  IAT_CHECK(parsed->contains_file("/work/src/x.cpp"));
+  IAT_CHECK(!parsed->contains_file("/work/xsrc/x.cpp"));
+  IAT_CHECK(parsed->overlaps("/work/src/x.cpp", 1, 1));
+  IAT_CHECK(parsed->overlaps("/work/src/x.cpp", 2, 2));
+  IAT_CHECK(!parsed->overlaps("/work/src/x.cpp", 3, 9));
+  IAT_CHECK(parsed->overlaps("/work/src/x.cpp", 8, 12));
+  IAT_CHECK(!fixpoint::ChangedLines::parse("+++ b/src/x.cpp\n@@ -1 +x @@\n").has_value());
+
+  const std::string diff_path = "temp_fixpoint_changes.diff";
+  {
+    std::ofstream diff(diff_path);
+    diff << "diff --git a/temp_fixpoint_test.cpp b/temp_fixpoint_test.cpp\n"
+            "--- a/temp_fixpoint_test.cpp\n"
+            "+++ b/temp_fixpoint_test.cpp\n"
+            "@@ -1,4 +1,4 @@\n"
+            " void f0() {}\n"
+            "-void f1() { int x = 0; }\n"
+            "+void f1() { int x = 1; }\n"
+            " void f2() {}\n"
+            " void f3() {}\n";
+  }
+
+  // The second translation unit doesn't include a changed file and isn't parsed at all.
+  const std::vector<std::string> sources = {
+      "void f0() {}\nvoid f1() { int x = 1; }\nvoid f2() {}\nvoid f3() {}\n",
+      "void g0() {}\n",
+  };
+
+  fixpoint::Workload workload;
+  workload.add_task<FunctionPolice>();
+  workload.add_task<SolvedFunctionCollector>();
+
+  const auto report = fixpoint::run_workload_on_sources(
+      sources, workload, [&](fixpoint::ToolSettings &settings) { settings.diff_file = diff_path; });
+
+  std::remove(diff_path.c_str());
+
+  IAT_CHECK(report.has_value());
+  IAT_CHECK_EQ(report->skipped_parses, 1u);
+  IAT_CHECK(static_cast<const FunctionPolice &>(*workload.get_tasks()[0]).names == std::vector<std::string>({"f1"}));
+  IAT_CHECK(static_cast<const SolvedFunctionCollector &>(*workload.get_tasks()[1]).names ==
+            std::vector<std::string>({"f1"}));
+
+  fixpoint::Workload missing;
+  missing.add_task<FunctionPolice>();
+  IAT_CHECK(!fixpoint::run_workload_on_sources(sources, missing, [](fixpoint::ToolSettings &settings) {
+               settings.diff_file = "temp_fixpoint_missing.diff";
+             }).has_value());
+
+  return true;
+}
+
+auto test_result_cache() -> bool
+{
+  const std::string cache_dir = "temp_fixpoint_result_cache";
+  const std::string header_path = "temp_fixpoint_cached.hpp";
+  const auto write_header = [&](const std::string &code) {
+    std::ofstream header(header_path);
+    header << code;
+  };
+
+  const std::vector<std::string> sources = {"#include \"temp_fixpoint_cached.hpp\"\nint a0;", "int b0;"};
+
+  const auto run = [&](std::vector<std::string> &names) {
+    fixpoint::Workload workload;
+    workload.add_task<CachedVarCollector>();
+
+    auto report = fixpoint::run_workload_on_sources(
+        sources, workload, [&](fixpoint::ToolSettings &settings) { settings.result_cache_dir = cache_dir; });
+    names = static_cast<const VarCollector &>(*workload.get_tasks().front()).names;
+    return report;
+  };
+
+  std::filesystem::remove_all(cache_dir);
+  write_header("int h0;\n");
+
+  std::vector<std::string> cold_names;
+  const auto cold = run(cold_names);
+
+  std::vector<std::string> warm_names;
+  const auto warm = run(warm_names);
+
+  // Only the translation unit including the header is invalidated.
+  write_header("int h1;\n");
+
+  std::vector<std::string> edited_names;
+  const auto edited = run(edited_names);
+
+  std::remove(header_path.c_str());
+  std::filesystem::remove_all(cache_dir);
+
+  IAT_CHECK(cold.has_value() && warm.has_value() && edited.has_value());
+  IAT_CHECK_EQ(cold->result_cache.hits, 0u);
+  IAT_CHECK_EQ(cold->result_cache.misses, 2u);
+  IAT_CHECK_EQ(warm->result_cache.hits, 2u);
+  IAT_CHECK_EQ(warm->result_cache.misses, 0u);
+  IAT_CHECK_EQ(edited->result_cache.hits, 1u);
+  IAT_CHECK_EQ(edited->result_cache.misses, 1u);
+  IAT_CHECK(cold_names == std::vector<std::string>({"h0", "a0", "b0"}));
+  IAT_CHECK(warm_names == cold_names);
+  IAT_CHECK(edited_names == std::vector<std::string>({"h1", "a0", "b0"}));
+
+  return true;
+}
+
+auto test_ast_cache() -> bool
+{
+  const std::string cache_dir = "temp_fixpoint_ast_cache";
+  const std::string header_path = "temp_fixpoint_ast_cached.hpp";
+  const auto write_header = [&](const std::string &code) {
+    std::ofstream header(header_path);
+    header << code;
+  };
+
+  const std::vector<std::string> sources = {
+      "#include \"temp_fixpoint_ast_cached.hpp\"\nint a0;\nvoid f0() { int x = h0; }",
+      "void g0() { int y = 0; }",
+  };
+
+  const auto run = [&](std::vector<std::string> &vars, std::vector<std::string> &functions) {
+    fixpoint::Workload workload;
+    workload.add_task<VarCollector>();
+    workload.add_task<SolvedFunctionCollector>();
+
+    auto report = fixpoint::run_workload_on_sources(
+        sources, workload, [&](fixpoint::ToolSettings &settings) { settings.ast_cache_dir = cache_dir; });
+    vars = static_cast<const VarCollector &>(*workload.get_tasks()[0]).names;
+    functions = static_cast<const SolvedFunctionCollector &>(*workload.get_tasks()[1]).names;
+    return report;
+  };
+
+  std::filesystem::remove_all(cache_dir);
+  write_header("int h0;\n");
+
+  std::vector<std::string> cold_vars;
+  std::vector<std::string> cold_functions;
+  const auto cold = run(cold_vars, cold_functions);
+
+  // Loaded ASTs still have their function bodies (and CFGs).
+  std::vector<std::string> warm_vars;
+  std::vector<std::string> warm_functions;
+  const auto warm = run(warm_vars, warm_functions);
+
+  write_header("int h0;\nint h1;\n");
+
+  std::vector<std::string> edited_vars;
+  std::vector<std::string> edited_functions;
+  const auto edited = run(edited_vars, edited_functions);
+
+  std::remove(header_path.c_str());
+  std::filesystem::remove_all(cache_dir);
+
+  IAT_CHECK(cold.has_value() && warm.has_value() && edited.has_value());
+  IAT_CHECK_EQ(cold->ast_cache.misses, 2u);
+  IAT_CHECK_EQ(warm->ast_cache.hits, 2u);
+  IAT_CHECK_EQ(edited->ast_cache.hits, 1u);
+  IAT_CHECK_EQ(edited->ast_cache.misses, 1u);
+  IAT_CHECK(cold_vars == std::vector<std::string>({"h0", "a0", "x", "y"}));
+  IAT_CHECK(cold_functions == std::vector<std::string>({"f0", "g0"}));
+  IAT_CHECK(warm_vars == cold_vars);
+  IAT_CHECK(warm_functions == cold_functions);
+  IAT_CHECK(edited_vars == std::vector<std::string>({"h0", "h1", "a0", "x", "y"}));
+
+  return true;
+}
+
+auto test_options_category_per_name() -> bool
+{
+  std::vector<const char *> argv = {"fixpoint_test", "temp_fixpoint_test.cpp", "--", "-std=c++20"};
+
+  IAT_CHECK(fixpoint::Options::create("Test", static_cast<int>(argv.size()), argv.data()).has_value());
+  IAT_CHECK(fixpoint::Options::create("Other", static_cast<int>(argv.size()), argv.data()).has_value());
+
+  const auto *jobs = llvm::cl::getRegisteredOptions().lookup("jobs");
+  IAT_CHECK(jobs != nullptr);
+
+  std::vector<std::string> categories;
+  for (const auto *category : jobs->Categories)
+    categories.emplace_back(category->getName());
+
+  IAT_CHECK(std::ranges::count(categories, "Test options") == 1);
+  IAT_CHECK(std::ranges::count(categories, "Other options") == 1);
+
+  return true;
+}
+
+#if !defined(_WIN32)
+auto test_process_shards() -> bool
+{
+  const std::vector<std::string> sources = {
+      "int a0; int a1;", "int b0;", "int c0; int c1; int c2;", "int d0;", "int e0; int e1;", "int f0;",
+  };
+
+  fixpoint::Workload sequential;
+  sequential.add_task<VarCollector>();
+  IAT_CHECK(fixpoint::run_workload_on_sources(sources, sequential, [](fixpoint::ToolSettings &) {}).has_value());
+
+  fixpoint::Workload sharded;
+  sharded.add_task<VarCollector>();
+  IAT_CHECK(fixpoint::run_workload_on_sources(sources, sharded, [](fixpoint::ToolSettings &settings) {
+              settings.processes = 3;
+            }).has_value());
+
+  IAT_CHECK(static_cast<const VarCollector &>(*sequential.get_tasks().front()).names ==
+            static_cast<const VarCollector &>(*sharded.get_tasks().front()).names);
+
+  return true;
+}
+
+auto test_process_shard_crash_isolation() -> bool
+{
+  const std::vector<std::string> sources = {"int a0;", "int crash_me;", "int c0;", "int d0;"};
+
+  fixpoint::Workload workload;
+  workload.add_task<VarCollector>();
+  workload.add_task<CrashingTask>();
+
+  const auto report = fixpoint::run_workload_on_sources(sources, workload, [](fixpoint::ToolSettings &settings) {
+    settings.processes = 2;
+    settings.crash_retries = 1;
+  });
+
+  IAT_CHECK(!report.has_value());
+
+  const auto &names = static_cast<const VarCollector &>(*workload.get_tasks().front()).names;
+  IAT_CHECK(names == std::vector<std::string>({"a0", "c0", "d0"}));
+
+  return true;
+}
+#endif
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_single_parse_shares_ast);
+IAT_ADD_TEST(test_per_task_parse);
+IAT_ADD_TEST(test_parallel_jobs);
+IAT_ADD_TEST(test_clone_reduction_is_deterministic);
+IAT_ADD_TEST(test_keep_going_reports_failed_files);
+IAT_ADD_TEST(test_keep_going_with_ast_cache);
+IAT_ADD_TEST(test_main_file_only_scope);
+IAT_ADD_TEST(test_skip_header_bodies);
+IAT_ADD_TEST(test_cfg_cache_is_shared);
+IAT_ADD_TEST(test_task_prefilters);
+IAT_ADD_TEST(test_changed_lines_mode);
+IAT_ADD_TEST(test_result_cache);
+IAT_ADD_TEST(test_ast_cache);
+IAT_ADD_TEST(test_options_category_per_name);
+#if !defined(_WIN32)
+IAT_ADD_TEST(test_process_shards);
+IAT_ADD_TEST(test_process_shard_crash_isolation);
+#endif
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, Tool)
\ No newline at end of file